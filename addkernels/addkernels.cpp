@@ -24,6 +24,8 @@
  *
  *******************************************************************************/
 #include "include_inliner.hpp"
+#include <miopen/compression.hpp>
+#include <miopen/embedded_kernels.hpp>
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
@@ -31,6 +33,8 @@
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 void Bin2Hex(std::istream& source,
              std::ostream& target,
@@ -45,11 +49,7 @@ void Bin2Hex(std::istream& source,
     std::streamoff blockStart = 0;
 
     if(variable.length() != 0)
-    {
-        target << "const size_t " << variable << "_SIZE = " << std::setbase(10) << sourceSize << ";"
-               << std::endl;
         target << "const unsigned char " << variable << "[] = {" << std::endl;
-    }
 
     target << std::setbase(16) << std::setfill('0');
     source.seekg(0, std::ios::beg);
@@ -84,6 +84,90 @@ void Bin2Hex(std::istream& source,
     {
         target << "};" << std::endl;
     }
+    target << std::setbase(10);
+}
+
+// Writes a minimal perfect hash table of the kernels, see miopen::EmbeddedKernelHash().
+void WriteKernelTable(std::ostream& target, const std::vector<std::string>& variables)
+{
+    const auto count = variables.size();
+    const auto hash  = [&](std::size_t variable, std::uint32_t seed) {
+        const auto& name = variables[variable];
+        return miopen::EmbeddedKernelHash(name.c_str(), name.size(), seed) % count;
+    };
+
+    std::vector<std::vector<std::size_t>> buckets(count);
+    for(std::size_t i = 0; i < count; ++i)
+        buckets[hash(i, 0)].push_back(i);
+
+    std::vector<std::size_t> order(count);
+    for(std::size_t i = 0; i < count; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](auto l, auto r) {
+        return buckets[l].size() > buckets[r].size();
+    });
+
+    const auto free_slot = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> slots(count, free_slot);
+    std::vector<long long> displacements(count, 0);
+    std::size_t next_free = 0;
+
+    for(const auto bucket : order)
+    {
+        const auto& items = buckets[bucket];
+        if(items.empty())
+            continue;
+        if(items.size() == 1)
+        {
+            while(slots[next_free] != free_slot)
+                ++next_free;
+            slots[next_free]      = items.front();
+            displacements[bucket] = -static_cast<long long>(next_free) - 1;
+            continue;
+        }
+
+        for(std::uint32_t seed = 1;; ++seed)
+        {
+            if(seed == (1u << 24))
+            {
+                std::cerr << "Failed to build the kernel table" << std::endl;
+                std::exit(1);
+            }
+            std::vector<std::size_t> taken;
+            for(const auto item : items)
+            {
+                const auto slot = hash(item, seed);
+                if(slots[slot] != free_slot ||
+                   std::find(taken.begin(), taken.end(), slot) != taken.end())
+                    break;
+                taken.push_back(slot);
+            }
+            if(taken.size() != items.size())
+                continue;
+            for(std::size_t i = 0; i < items.size(); ++i)
+                slots[taken[i]] = items[i];
+            displacements[bucket] = seed;
+            break;
+        }
+    }
+
+    target << "const size_t MIOPEN_KERNELS_COUNT = " << count << ";" << std::endl;
+    target << "const long long MIOPEN_KERNELS_DISPLACEMENTS[] = {" << std::endl;
+    for(const auto displacement : displacements)
+        target << displacement << "," << std::endl;
+    if(count == 0)
+        target << "0" << std::endl;
+    target << "};" << std::endl;
+    target << "const miopen::EmbeddedKernel MIOPEN_KERNELS_TABLE[] = {" << std::endl;
+    for(const auto slot : slots)
+    {
+        const auto& variable = variables[slot];
+        target << "{\"" << variable << "\", " << variable << ", " << variable << "_SIZE, "
+               << variable << "_COMPRESSED_SIZE, " << variable << "_INCLUDES}," << std::endl;
+    }
+    if(count == 0)
+        target << "{nullptr, nullptr, 0, 0, false}" << std::endl;
+    target << "};" << std::endl;
 }
 
 void PrintHelp()
@@ -99,6 +183,9 @@ void PrintHelp()
     std::cout << "           -l[ine-size] <number>: bytes in one line. Default: 16." << std::endl;
     std::cout << "           -b[uffer] <number>: read buffer size. Default: 512." << std::endl;
     std::cout << "           -g[uard] <string>: guard name. Default: no guard" << std::endl;
+    std::cout << "           -n[o-compress]: store the files uncompressed." << std::endl;
+    std::cout << "           -i[nline-includes]: inline the includes of each assembly file."
+              << std::endl;
 }
 
 [[gnu::noreturn]] void WrongUsage(const std::string& error)
@@ -116,11 +203,104 @@ void PrintHelp()
     WrongUsage(ss.str());
 }
 
-void Process(std::string sourcePath, std::ostream& target, size_t bufferSize, size_t lineSize)
+void WriteData(const std::string& text,
+               const std::string& variable,
+               bool includes,
+               std::ostream& target,
+               size_t bufferSize,
+               size_t lineSize,
+               bool compress)
+{
+    std::vector<unsigned char> compressed;
+    if(compress)
+        compressed = miopen::CompressBlock(text.data(), text.size());
+    // Binaries may not compress at all.
+    if(compressed.empty() || compressed.size() >= text.size())
+        compressed.clear();
+
+    target << "const size_t " << variable << "_SIZE = " << text.size() << ";" << std::endl;
+    target << "const size_t " << variable << "_COMPRESSED_SIZE = " << compressed.size() << ";"
+           << std::endl;
+    target << "const bool " << variable << "_INCLUDES = " << (includes ? "true" : "false") << ";"
+           << std::endl;
+
+    std::istringstream data(compressed.empty() ? text
+                                               : std::string(compressed.begin(), compressed.end()));
+    Bin2Hex(data, target, variable, true, bufferSize, lineSize);
+}
+
+// Root directory and path of an included file.
+using Include = std::pair<std::string, std::string>;
+
+// Inlines the includes of an assembly file, or keeps them to be resolved when the file is
+// loaded, see miopen::EmbeddedIncludeName().
+std::string Inline(std::istream& source,
+                   const std::string& root,
+                   const std::string& sourcePath,
+                   bool keepIncludes,
+                   std::vector<Include>& includes)
+{
+    IncludeInliner inliner;
+    inliner.keep_includes = keepIncludes;
+    std::ostringstream result;
+
+    try
+    {
+        inliner.Process(source, result, root, sourcePath);
+    }
+    catch(const InlineException& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        std::exit(1);
+    }
+
+    for(const auto& file : inliner.included_files)
+    {
+        const auto include = std::make_pair(root, file);
+        if(std::find(includes.begin(), includes.end(), include) == includes.end())
+            includes.push_back(include);
+    }
+    return result.str();
+}
+
+// Embeds each of the files included by the assembly kernels once.
+void ProcessIncludes(const std::vector<Include>& includes,
+                     std::ostream& target,
+                     size_t bufferSize,
+                     size_t lineSize,
+                     bool compress,
+                     std::vector<std::string>& variables)
+{
+    // The nested includes have been listed with the kernels.
+    std::vector<Include> nested;
+    for(const auto& include : includes)
+    {
+        const auto path = include.first + include.second;
+        std::ifstream sourceFile(path, std::ios::in | std::ios::binary);
+        const auto text     = Inline(sourceFile, include.first, path, true, nested);
+        const auto variable = miopen::EmbeddedIncludeName(include.second);
+        variables.push_back(variable);
+        WriteData(text,
+                  variable,
+                  text.find(".include") != std::string::npos,
+                  target,
+                  bufferSize,
+                  lineSize,
+                  compress);
+    }
+}
+
+void Process(std::string sourcePath,
+             std::ostream& target,
+             size_t bufferSize,
+             size_t lineSize,
+             bool compress,
+             bool keepIncludes,
+             std::vector<std::string>& variables,
+             std::vector<Include>& includes)
 {
     std::string fileName(sourcePath);
     std::string extension, root;
-    std::stringstream inlinerTemp;
     auto extPos   = fileName.rfind('.');
     auto slashPos = fileName.rfind('/');
 
@@ -138,7 +318,6 @@ void Process(std::string sourcePath, std::ostream& target, size_t bufferSize, si
 
     std::string variable(fileName);
     std::ifstream sourceFile(sourcePath, std::ios::in | std::ios::binary);
-    std::istream* source = &sourceFile;
 
     if(!sourceFile.good())
     {
@@ -146,25 +325,23 @@ void Process(std::string sourcePath, std::ostream& target, size_t bufferSize, si
         std::exit(1);
     }
 
+    std::string text;
+    bool hasIncludes = false;
     if(extension == "s")
     {
-        IncludeInliner inliner;
-
-        try
-        {
-            inliner.Process(sourceFile, inlinerTemp, root, sourcePath);
-        }
-        catch(const InlineException& ex)
-        {
-            std::cerr << ex.what() << std::endl;
-            std::exit(1);
-        }
-
-        source = &inlinerTemp;
+        text        = Inline(sourceFile, root, sourcePath, keepIncludes, includes);
+        hasIncludes = keepIncludes && text.find(".include") != std::string::npos;
+    }
+    else
+    {
+        std::ostringstream content;
+        content << sourceFile.rdbuf();
+        text = content.str();
     }
 
     std::transform(variable.begin(), variable.end(), variable.begin(), ::toupper);
-    Bin2Hex(*source, target, variable, true, bufferSize, lineSize);
+    variables.push_back(variable);
+    WriteData(text, variable, hasIncludes, target, bufferSize, lineSize, compress);
 }
 
 int main(int argsn, char** args)
@@ -178,6 +355,8 @@ int main(int argsn, char** args)
     std::string guard;
     size_t bufferSize = 512;
     size_t lineSize   = 16;
+    bool compress     = true;
+    bool keepIncludes = true;
 
     std::ofstream targetFile;
     std::ostream* target = &std::cout;
@@ -196,11 +375,23 @@ int main(int argsn, char** args)
                 *target << "#define " << guard << std::endl;
                 *target << "#include <stddef.h>" << std::endl;
             }
+            *target << "#include <miopen/embedded_kernels.hpp>" << std::endl;
 
+            std::vector<std::string> variables;
+            std::vector<Include> includes;
             while(++i < argsn)
             {
-                Process(args[i], *target, bufferSize, lineSize);
+                Process(args[i],
+                        *target,
+                        bufferSize,
+                        lineSize,
+                        compress,
+                        keepIncludes,
+                        variables,
+                        includes);
             }
+            ProcessIncludes(includes, *target, bufferSize, lineSize, compress, variables);
+            WriteKernelTable(*target, variables);
 
             if(guard.length() > 0)
             {
@@ -220,6 +411,10 @@ int main(int argsn, char** args)
             bufferSize = std::stol(args[++i]);
         else if(arg == "g" || arg == "guard")
             guard = args[++i];
+        else if(arg == "n" || arg == "no-compress")
+            compress = false;
+        else if(arg == "i" || arg == "inline-includes")
+            keepIncludes = false;
         else
             UnknownArgument(arg);
     }
@@ -126,6 +126,23 @@ void IncludeInliner::ProcessCore(std::istream& input,
             if(!include_file.good())
                 continue;
 
+            if(keep_includes)
+            {
+                if(std::find(included_files.begin(), included_files.end(), include_file_path) ==
+                   included_files.end())
+                    included_files.push_back(include_file_path);
+
+                // Still walk the file, for the nested includes and the depth limit.
+                std::ostringstream nested;
+                ProcessCore(include_file, nested, root, include_file_path, current_line);
+
+                if(output.tellp() > 0)
+                    output << std::endl;
+
+                output << line;
+                continue;
+            }
+
             ProcessCore(include_file, output, root, include_file_path, current_line);
         }
         else
@@ -30,6 +30,7 @@
 #include <ostream>
 #include <memory>
 #include <stack>
+#include <vector>
 
 class InlineException : public std::exception
 {
@@ -50,6 +51,10 @@ class IncludeInliner
 {
     public:
     int include_depth_limit = 256;
+    // Keep the .include directives instead of inlining the files, which are then listed in
+    // included_files, relative to the root, once each.
+    bool keep_includes = false;
+    std::vector<std::string> included_files;
 
     void Process(std::istream& input,
                  std::ostream& output,
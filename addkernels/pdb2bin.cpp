@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db_format.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+void PrintHelp()
+{
+    std::cout << "Usage: pdb2bin {<option>}" << std::endl;
+    std::cout << "Converts a text perf db into the binary perf db format." << std::endl;
+    std::cout << "Option format: -<option name>[ <option value>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "[REQUIRED] -s[ource] <path to file>: text db to be converted." << std::endl;
+    std::cout << "[REQUIRED] -t[arget] <path>: binary db to be written." << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+[[gnu::noreturn]] void UnknownArgument(const std::string& arg)
+{
+    std::ostringstream ss;
+    ss << "unknown argument - " << arg;
+    WrongUsage(ss.str());
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn == 1)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    std::string sourcePath;
+    std::string targetPath;
+
+    for(int i = 1; i < argsn; ++i)
+    {
+        std::string arg(args[i] + 1);
+        std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+
+        if(i + 1 >= argsn)
+            WrongUsage("value is missing for " + arg);
+
+        if(arg == "s" || arg == "source")
+            sourcePath = args[++i];
+        else if(arg == "t" || arg == "target")
+            targetPath = args[++i];
+        else
+            UnknownArgument(arg);
+    }
+
+    if(sourcePath.empty())
+        WrongUsage("source key is required");
+    if(targetPath.empty())
+        WrongUsage("target key is required");
+
+    std::ifstream source(sourcePath);
+
+    if(!source.good())
+    {
+        std::cerr << "File not found: " << sourcePath << std::endl;
+        return 1;
+    }
+
+    const auto records = miopen::binary_db::ReadTextDb(source, std::cerr, sourcePath);
+    std::ofstream target(targetPath, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if(!target.good())
+    {
+        std::cerr << "File is unwritable: " << targetPath << std::endl;
+        return 1;
+    }
+
+    if(!miopen::binary_db::WriteBinaryDb(records, target))
+    {
+        std::cerr << "Db is too large for the binary format: " << sourcePath << std::endl;
+        return 1;
+    }
+
+    target.close();
+
+    if(!target)
+    {
+        std::cerr << "Failed to write: " << targetPath << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
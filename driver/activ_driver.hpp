@@ -74,6 +74,7 @@ class ActivationDriver : public Driver
     int AllocateBuffersAndCopy();
 
     int RunForwardGPU();
+    int PrecompileForward(miopenHandle_t precompile_handle);
     int RunForwardCPU(); // Verify implements it
 
     int RunBackwardGPU();
@@ -244,6 +245,13 @@ int ActivationDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
     return miopenStatusSuccess;
 }
 
+template <typename Tgpu, typename Tref>
+int ActivationDriver<Tgpu, Tref>::PrecompileForward(miopenHandle_t precompile_handle)
+{
+    return miopenPrecompileActivationForward(
+        precompile_handle, activDesc, inputTensor, outputTensor);
+}
+
 template <typename Tgpu, typename Tref>
 int ActivationDriver<Tgpu, Tref>::RunForwardGPU()
 {
@@ -89,6 +89,7 @@ class BatchNormDriver : public Driver
     int AllocateBuffersAndCopy();
 
     int RunForwardGPU();
+    int PrecompileForward(miopenHandle_t precompile_handle);
     int RunForwardCPU();
 
     int RunBackwardGPU();
@@ -764,6 +765,13 @@ void BatchNormDriver<Tgpu, Tref>::runGPUFwdTrain(Tref epsilon, Tref eAF, float a
 #endif
 }
 
+template <typename Tgpu, typename Tref>
+int BatchNormDriver<Tgpu, Tref>::PrecompileForward(miopenHandle_t precompile_handle)
+{
+    return miopenPrecompileBatchNormalizationForwardInference(
+        precompile_handle, bn_mode, inputTensor, outputTensor, biasScaleTensor);
+}
+
 template <typename Tgpu, typename Tref>
 int BatchNormDriver<Tgpu, Tref>::RunForwardGPU()
 {
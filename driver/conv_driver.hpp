@@ -149,6 +149,7 @@ class ConvDriver : public Driver
                     int request_algo_count,
                     std::vector<miopenConvAlgoPerf_t>& perf_results);
     int RunForwardGPU();
+    int PrecompileForward(miopenHandle_t precompile_handle);
     int RunForwardCPU();
 
     int FindBackwardData(int& ret_algo_count,
@@ -622,6 +623,13 @@ int ConvDriver<Tgpu, Tref, Tfile>::FindForward(int& ret_algo_count,
         (inflags.GetValueInt("search") == 1) ? true : false);
 }
 
+template <typename Tgpu, typename Tref, typename Tfile>
+int ConvDriver<Tgpu, Tref, Tfile>::PrecompileForward(miopenHandle_t precompile_handle)
+{
+    return miopenPrecompileConvolutionForward(
+        precompile_handle, inputTensor, weightTensor, convDesc, outputTensor);
+}
+
 template <typename Tgpu, typename Tref, typename Tfile>
 int ConvDriver<Tgpu, Tref, Tfile>::RunForwardGPU()
 {
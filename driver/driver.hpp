@@ -132,7 +132,7 @@ void PadBufferSize(size_t& sz, int datatype_sz)
 {
     printf("Usage: ./driver *base_arg* *other_args*\n");
     printf("Supported Base Arguments: conv[fp16], pool[fp16], lrn[fp16], activ[fp16], "
-           "softmax[fp16], bnorm[fp16], rnn, gemm\n");
+           "softmax[fp16], bnorm[fp16], rnn, gemm, precompile\n");
     exit(0);
 }
 
@@ -149,7 +149,8 @@ std::string ParseBaseArg(int argc, char* argv[])
     if(arg != "conv" && arg != "convfp16" && arg != "pool" && arg != "poolfp16" && arg != "lrn" &&
        arg != "lrnfp16" && arg != "activ" && arg != "activfp16" && arg != "softmax" &&
        arg != "softmaxfp16" && arg != "bnorm" && arg != "bnormfp16" &&
-       arg != "rnn" /*&& arg != "rnnfp16" */ && arg != "gemm" /*&& arg != "gemmfp16"*/)
+       arg != "rnn" /*&& arg != "rnnfp16" */ && arg != "gemm" /*&& arg != "gemmfp16"*/ &&
+       arg != "precompile")
 
     {
         printf("Invalid Base Input Argument\n");
@@ -199,6 +200,12 @@ class Driver
     virtual int RunBackwardGPU()         = 0;
     virtual int VerifyBackward()         = 0;
 
+    // Starts compiling the kernels of the forward layer on the handle, without running it.
+    virtual int PrecompileForward(miopenHandle_t /*precompile_handle*/)
+    {
+        return miopenStatusNotImplemented;
+    }
+
     protected:
     miopenHandle_t handle;
     miopenDataType_t data_type;
@@ -70,6 +70,7 @@ class LRNDriver : public Driver
     int AllocateBuffersAndCopy();
 
     int RunForwardGPU();
+    int PrecompileForward(miopenHandle_t precompile_handle);
     int RunForwardCPU();
 
     int RunBackwardGPU();
@@ -286,6 +287,13 @@ int LRNDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
     return miopenStatusSuccess;
 }
 
+template <typename Tgpu, typename Tref>
+int LRNDriver<Tgpu, Tref>::PrecompileForward(miopenHandle_t precompile_handle)
+{
+    return miopenPrecompileLRNForward(
+        precompile_handle, lrnDesc, inputTensor, outputTensor, do_backward);
+}
+
 template <typename Tgpu, typename Tref>
 int LRNDriver<Tgpu, Tref>::RunForwardGPU()
 {
@@ -33,87 +33,96 @@
 #include "gemm_driver.hpp"
 #include "lrn_driver.hpp"
 #include "pool_driver.hpp"
+#include "precompile_driver.hpp"
 #include "softmax_driver.hpp"
 #include "rnn_driver.hpp"
 #include "miopen/config.h"
 
-int main(int argc, char* argv[])
+static Driver* MakeDriver(const std::string& base_arg)
 {
-    // show command
-    std::cout << "MIOpenDriver:";
-    for(int i = 1; i < argc; i++)
-        std::cout << " " << argv[i];
-    std::cout << std::endl;
-
-    std::string base_arg = ParseBaseArg(argc, argv);
-
-    Driver* drv;
     if(base_arg == "conv")
     {
         // Maintain compatibility with legacy verification cache files (computed in doubles, stored
         // as floats).
-        drv = new ConvDriver<float, double, float>();
+        return new ConvDriver<float, double, float>();
     }
     else if(base_arg == "convfp16")
     {
-        drv = new ConvDriver<float16, double>();
+        return new ConvDriver<float16, double>();
     }
     else if(base_arg == "pool")
     {
-        drv = new PoolDriver<float, double>();
+        return new PoolDriver<float, double>();
     }
     else if(base_arg == "poolfp16")
     {
-        drv = new PoolDriver<float16, double>();
+        return new PoolDriver<float16, double>();
     }
     else if(base_arg == "lrn")
     {
-        drv = new LRNDriver<float, double>();
+        return new LRNDriver<float, double>();
     }
     else if(base_arg == "lrnfp16")
     {
-        drv = new LRNDriver<float16, double>();
+        return new LRNDriver<float16, double>();
     }
     else if(base_arg == "activ")
     {
-        drv = new ActivationDriver<float, double>();
+        return new ActivationDriver<float, double>();
     }
     else if(base_arg == "activfp16")
     {
-        drv = new ActivationDriver<float16, double>();
+        return new ActivationDriver<float16, double>();
     }
     else if(base_arg == "softmax")
     {
-        drv = new SoftmaxDriver<float, double>();
+        return new SoftmaxDriver<float, double>();
     }
     else if(base_arg == "softmaxfp16")
     {
-        drv = new SoftmaxDriver<float16, double>();
+        return new SoftmaxDriver<float16, double>();
     }
     else if(base_arg == "gemm")
     {
-        drv = new GemmDriver<float>();
+        return new GemmDriver<float>();
     }
     // TODO half is not supported in gemm
     //#if MIOPEN_USE_MIOPENGEMM
     //    else if(base_arg == "gemmfp16")
     //    {
-    //        drv = new GemmDriver<float16>();
+    //        return new GemmDriver<float16>();
     //    }
     //#endif
     else if(base_arg == "bnorm")
     {
-        drv = new BatchNormDriver<float, double>();
+        return new BatchNormDriver<float, double>();
     }
     else if(base_arg == "bnormfp16")
     {
-        drv = new BatchNormDriver<float16, double>();
+        return new BatchNormDriver<float16, double>();
     }
     else if(base_arg == "rnn")
     {
-        drv = new RNNDriver<float>();
+        return new RNNDriver<float>();
     }
-    else
+    return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    // show command
+    std::cout << "MIOpenDriver:";
+    for(int i = 1; i < argc; i++)
+        std::cout << " " << argv[i];
+    std::cout << std::endl;
+
+    std::string base_arg = ParseBaseArg(argc, argv);
+
+    if(base_arg == "precompile")
+        return RunPrecompile(argc, argv, MakeDriver);
+
+    Driver* drv = MakeDriver(base_arg);
+    if(drv == nullptr)
     {
         printf("Incorrect BaseArg\n");
         exit(0);
@@ -0,0 +1,505 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db.hpp>
+#include <miopen/legacy_exhaustive_search.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using miopen::Db;
+using miopen::DbWriteMode;
+using miopen::solver::LegacyPerformanceConfig;
+
+/// Problem config of a realistic size, e.g. "17-28-28-3x3-64-28-28-16-1x1-1x1-1x1-0-NCHW-FP32-F".
+struct BenchKey
+{
+    std::size_t index;
+
+    template <class Stream>
+    void Serialize(Stream& stream) const
+    {
+        stream << index << "-28-28-3x3-64-28-28-16-1x1-1x1-1x1-0-NCHW-FP32-F";
+    }
+};
+
+const char* StoredId() { return "ConvOclDirectFwd"; }
+// Added by Update and removed by Remove, so that the size of the db is stable.
+const char* UpdatedId() { return "ConvOclDirectFwdBench"; }
+
+LegacyPerformanceConfig MakeValues(std::size_t seed)
+{
+    LegacyPerformanceConfig config;
+    config.grp_tile1       = 16;
+    config.grp_tile0       = 16;
+    config.in_tile1        = 16;
+    config.in_tile0        = 16;
+    config.out_pix_tile1   = 2;
+    config.out_pix_tile0   = 2;
+    config.n_out_pix_tiles = 8;
+    config.n_in_data_tiles = 2;
+    config.n_stacks        = static_cast<int>(seed % 4) + 1;
+    return config;
+}
+
+enum class Operation
+{
+    FindRecord,
+    Update,
+    Remove,
+    LockShared,
+    LockExclusive,
+};
+
+const char* ToString(Operation op)
+{
+    switch(op)
+    {
+    case Operation::FindRecord: return "FindRecord";
+    case Operation::Update: return "Update";
+    case Operation::Remove: return "Remove";
+    case Operation::LockShared: return "LockFile shared";
+    case Operation::LockExclusive: return "LockFile exclusive";
+    }
+    return "";
+}
+
+struct Options
+{
+    std::vector<std::size_t> sizes = {1000, 100000, 1000000};
+    std::size_t readers            = 4;
+    std::size_t writers            = 1;
+    std::size_t reads              = 1000;
+    std::size_t writes             = 20;
+    bool threads                   = true;
+    bool processes                 = true;
+    DbWriteMode mode               = DbWriteMode::Default;
+};
+
+/// Latencies in microseconds. Memory is shared with forked workers.
+class Samples
+{
+    public:
+    Samples(std::size_t count_) : count(count_)
+    {
+        const auto size = std::max<std::size_t>(count, 1) * sizeof(double);
+        const auto mem =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if(mem == MAP_FAILED)
+        {
+            std::cerr << "Error: unable to allocate " << size << " bytes" << std::endl;
+            std::exit(1);
+        }
+        data = static_cast<double*>(mem);
+    }
+
+    Samples(const Samples&) = delete;
+    Samples& operator=(const Samples&) = delete;
+    ~Samples() { munmap(data, std::max<std::size_t>(count, 1) * sizeof(double)); }
+
+    double* Data() { return data; }
+    std::vector<double> Sorted() const
+    {
+        std::vector<double> sorted(data, data + count);
+        std::sort(sorted.begin(), sorted.end());
+        return sorted;
+    }
+    std::size_t Size() const { return count; }
+
+    private:
+    std::size_t count;
+    double* data;
+};
+
+template <class F>
+double Measure(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+void GenerateDb(const std::string& path, std::size_t records)
+{
+    std::ofstream file(path);
+
+    for(std::size_t i = 0; i < records; ++i)
+    {
+        BenchKey{i}.Serialize(file);
+        file << '=' << StoredId() << ':';
+        MakeValues(i).Serialize(file);
+        file << '\n';
+    }
+
+    if(!file)
+    {
+        std::cerr << "Error: unable to write " << path << std::endl;
+        std::exit(1);
+    }
+}
+
+/// Worker of a scenario. Readers fill out with FindRecord latencies, writers alternate Update
+/// (even samples) and Remove (odd samples) of the same record.
+struct Worker
+{
+    bool writer;
+    std::size_t seed;
+    double* out;
+    std::size_t ops;
+
+    void Run(const std::string& path, std::size_t records, DbWriteMode mode) const
+    {
+        Db db(path, mode);
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<std::size_t> dist(0, records - 1);
+        std::size_t key = 0;
+
+        for(std::size_t i = 0; i < ops; ++i)
+        {
+            if(!writer)
+            {
+                out[i] = Measure([&]() {
+                    if(!db.FindRecord(BenchKey{dist(rng)}))
+                        std::cerr << "Error: record not found" << std::endl;
+                });
+            }
+            else if(i % 2 == 0)
+            {
+                key    = dist(rng);
+                out[i] = Measure([&]() {
+                    if(!db.Update(BenchKey{key}, UpdatedId(), MakeValues(i)))
+                        std::cerr << "Error: update failed" << std::endl;
+                });
+            }
+            else
+            {
+                out[i] = Measure([&]() {
+                    if(!db.Remove(BenchKey{key}, UpdatedId()))
+                        std::cerr << "Error: remove failed" << std::endl;
+                });
+            }
+        }
+    }
+};
+
+struct Result
+{
+    Operation op;
+    std::vector<double> samples;
+    double wall_time; // us, the whole scenario
+};
+
+void Print(const std::string& scenario, const Result& result)
+{
+    const auto& s = result.samples;
+    if(s.empty())
+        return;
+
+    const auto percentile = [&](double p) {
+        const auto index = static_cast<std::size_t>(std::ceil(p * s.size()));
+        return s[std::min(std::max<std::size_t>(index, 1), s.size()) - 1];
+    };
+
+    std::cout << std::left << std::setw(11) << scenario << std::setw(20) << ToString(result.op)
+              << std::right << std::setw(9) << s.size() << std::fixed << std::setprecision(1)
+              << std::setw(14) << s.size() * 1e6 / result.wall_time << std::setw(12)
+              << percentile(0.5) << std::setw(12) << percentile(0.99) << std::setw(12)
+              << s.back() << std::endl;
+}
+
+/// Runs readers and writers concurrently, either as threads or as forked processes.
+std::vector<Result> RunConcurrent(const Options& options,
+                                  const std::string& path,
+                                  std::size_t records,
+                                  bool fork_workers)
+{
+    Samples reads(options.readers * options.reads);
+    Samples writes(options.writers * options.writes);
+    std::vector<Worker> workers;
+
+    for(std::size_t i = 0; i < options.readers; ++i)
+        workers.push_back({false, i, reads.Data() + i * options.reads, options.reads});
+    for(std::size_t i = 0; i < options.writers; ++i)
+        workers.push_back(
+            {true, options.readers + i, writes.Data() + i * options.writes, options.writes});
+
+    const auto wall_time = Measure([&]() {
+        if(fork_workers)
+        {
+            // Otherwise buffered output is duplicated by children.
+            std::cout.flush();
+            std::vector<pid_t> children;
+            for(const auto& worker : workers)
+            {
+                const auto pid = fork();
+                if(pid == 0)
+                {
+                    worker.Run(path, records, options.mode);
+                    _exit(0);
+                }
+                if(pid < 0)
+                {
+                    std::cerr << "Error: fork failed" << std::endl;
+                    std::exit(1);
+                }
+                children.push_back(pid);
+            }
+            for(const auto child : children)
+            {
+                int status = 0;
+                waitpid(child, &status, 0);
+                if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                    std::cerr << "Error: worker " << child << " failed" << std::endl;
+            }
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            for(const auto& worker : workers)
+                threads.emplace_back([&]() { worker.Run(path, records, options.mode); });
+            for(auto& thread : threads)
+                thread.join();
+        }
+    });
+
+    std::vector<Result> results;
+    results.push_back({Operation::FindRecord, reads.Sorted(), wall_time});
+
+    const auto all_writes = std::vector<double>(writes.Data(), writes.Data() + writes.Size());
+    std::vector<double> updates, removes;
+    for(std::size_t i = 0; i < all_writes.size(); ++i)
+        ((i % options.writes) % 2 == 0 ? updates : removes).push_back(all_writes[i]);
+    std::sort(updates.begin(), updates.end());
+    std::sort(removes.begin(), removes.end());
+    results.push_back({Operation::Update, updates, wall_time});
+    results.push_back({Operation::Remove, removes, wall_time});
+    return results;
+}
+
+std::vector<Result> RunLockFile(const Options& options, const std::string& path)
+{
+    auto& lock_file = miopen::LockFile::Get(path.c_str());
+    std::vector<Result> results;
+
+    for(const auto op : {Operation::LockShared, Operation::LockExclusive})
+    {
+        Result result{op, {}, 0};
+        result.wall_time = Measure([&]() {
+            for(std::size_t i = 0; i < options.reads; ++i)
+            {
+                result.samples.push_back(Measure([&]() {
+                    if(op == Operation::LockShared)
+                    {
+                        lock_file.lock_shared();
+                        lock_file.unlock_shared();
+                    }
+                    else
+                    {
+                        lock_file.lock();
+                        lock_file.unlock();
+                    }
+                }));
+            }
+        });
+        std::sort(result.samples.begin(), result.samples.end());
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+void Run(const Options& options)
+{
+    std::cout << "Readers: " << options.readers << " x " << options.reads
+              << " FindRecord, writers: " << options.writers << " x " << options.writes
+              << " Update/Remove" << std::endl;
+
+    for(const auto records : options.sizes)
+    {
+        const miopen::TmpDir dir("perfdb_bench");
+        const auto path = (dir.path / "bench.cd.pdb.txt").string();
+
+        GenerateDb(path, records);
+
+        std::cout << std::endl
+                  << "Records: " << records << ", file size: "
+                  << boost::filesystem::file_size(path) / 1024 << " KiB" << std::endl;
+        std::cout << std::left << std::setw(11) << "Scenario" << std::setw(20) << "Operation"
+                  << std::right << std::setw(9) << "Count" << std::setw(14) << "Ops/s"
+                  << std::setw(12) << "p50, us" << std::setw(12) << "p99, us" << std::setw(12)
+                  << "max, us" << std::endl;
+
+        for(const auto& result : RunLockFile(options, path))
+            Print("lock", result);
+
+        {
+            Options single = options;
+            single.readers = 1;
+            single.writers = 0;
+            for(const auto& result : RunConcurrent(single, path, records, false))
+                Print("single", result);
+            single.readers = 0;
+            single.writers = 1;
+            for(const auto& result : RunConcurrent(single, path, records, false))
+                Print("single", result);
+        }
+
+        if(options.threads)
+            for(const auto& result : RunConcurrent(options, path, records, false))
+                Print("threads", result);
+
+        if(options.processes)
+            for(const auto& result : RunConcurrent(options, path, records, true))
+                Print("processes", result);
+    }
+}
+
+void PrintHelp()
+{
+    std::cout << "Usage: MIOpenPerfDbBench {<option>}" << std::endl;
+    std::cout << "Measures latencies of perf db operations on generated dbs." << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "-s[izes] <n>{,<n>}: numbers of records in the dbs, 1000,100000,1000000 by "
+                 "default."
+              << std::endl;
+    std::cout << "-r[eaders] <n>: concurrent readers, 4 by default." << std::endl;
+    std::cout << "-w[riters] <n>: concurrent writers, 1 by default." << std::endl;
+    std::cout << "-reads <n>: FindRecord calls per reader, 1000 by default." << std::endl;
+    std::cout << "-writes <n>: Update and Remove calls per writer, 20 by default." << std::endl;
+    std::cout << "-m[ode] rewrite|journal|snapshot: write mode of the db, defined by the "
+                 "environment by default."
+              << std::endl;
+    std::cout << "-no-threads: skips the scenario with workers in threads." << std::endl;
+    std::cout << "-no-processes: skips the scenario with workers in processes." << std::endl;
+    std::cout << "-h[elp]: prints this help." << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+std::size_t ParseCount(const std::string& option, const std::string& value)
+{
+    char* end;
+    const auto count = std::strtoul(value.c_str(), &end, 10);
+    if(value.empty() || *end != '\0')
+        WrongUsage("invalid value of " + option + " - " + value);
+    return count;
+}
+
+} // namespace
+
+int main(int argsn, char** args)
+{
+    Options options;
+
+    for(int i = 1; i < argsn; ++i)
+    {
+        auto option = std::string(args[i]);
+
+        if(option.empty() || option[0] != '-')
+            WrongUsage("unexpected argument - " + option);
+
+        option = option.substr(1);
+        std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+
+        const auto value = [&]() {
+            if(i + 1 >= argsn)
+                WrongUsage("value is missing for " + option);
+            return std::string(args[++i]);
+        };
+
+        if(option == "s" || option == "sizes")
+        {
+            std::istringstream sizes(value());
+            std::string size;
+            options.sizes.clear();
+            while(std::getline(sizes, size, ','))
+                options.sizes.push_back(ParseCount(option, size));
+            if(std::count(options.sizes.begin(), options.sizes.end(), 0) != 0)
+                WrongUsage("empty dbs are not supported");
+        }
+        else if(option == "r" || option == "readers")
+            options.readers = ParseCount(option, value());
+        else if(option == "w" || option == "writers")
+            options.writers = ParseCount(option, value());
+        else if(option == "reads")
+            options.reads = ParseCount(option, value());
+        else if(option == "writes")
+            options.writes = ParseCount(option, value());
+        else if(option == "m" || option == "mode")
+        {
+            const auto mode = value();
+            if(mode == "rewrite")
+                options.mode = DbWriteMode::Rewrite;
+            else if(mode == "journal")
+                options.mode = DbWriteMode::Journal;
+            else if(mode == "snapshot")
+                options.mode = DbWriteMode::Snapshot;
+            else
+                WrongUsage("unknown mode - " + mode);
+        }
+        else if(option == "no-threads")
+            options.threads = false;
+        else if(option == "no-processes")
+            options.processes = false;
+        else if(option == "h" || option == "help")
+        {
+            PrintHelp();
+            return 0;
+        }
+        else
+            WrongUsage("unknown argument - " + option);
+    }
+
+    Run(options);
+    return 0;
+}
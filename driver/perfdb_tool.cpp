@@ -0,0 +1,271 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db_format.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using miopen::ConvolutionContext;
+using miopen::DbRecord;
+
+struct Stats
+{
+    miopen::binary_db::TextDbStats lines;
+    std::size_t ill_formed_contents = 0;
+    std::size_t conflicts           = 0;
+    std::size_t unknown_ids         = 0;
+    std::size_t not_searchable_ids  = 0;
+    std::size_t invalid_values      = 0;
+    std::size_t ill_formed_keys     = 0;
+    std::size_t records             = 0;
+    std::size_t values              = 0;
+};
+
+/// Adds records of a db to the result. As in DbRecord::Merge(), values that are already in
+/// the result are kept.
+void MergeDb(const std::string& path, std::map<std::string, DbRecord>& result, Stats& stats)
+{
+    std::ifstream file(path);
+
+    if(!file)
+    {
+        std::cerr << "Error: unable to read " << path << std::endl;
+        std::exit(1);
+    }
+
+    const auto records = miopen::binary_db::ReadTextDb(file, std::cerr, path, &stats.lines);
+
+    for(const auto& text_record : records)
+    {
+        DbRecord record(text_record.first);
+
+        if(!record.ParseContents(text_record.second))
+        {
+            std::cerr << "Ill-formed record: " << path << ": " << text_record.first << std::endl;
+            ++stats.ill_formed_contents;
+            continue;
+        }
+
+        const auto inserted = result.emplace(text_record.first, record);
+        if(inserted.second)
+            continue;
+
+        auto& merged         = inserted.first->second;
+        const auto& contents = merged.GetContents();
+
+        for(const auto& pair : record.GetContents())
+        {
+            const auto same_id = std::find_if(
+                contents.begin(), contents.end(), [&](const std::pair<std::string, std::string>& p) {
+                    return p.first == pair.first;
+                });
+            if(same_id != contents.end() && same_id->second != pair.second)
+                ++stats.conflicts;
+        }
+
+        merged.Merge(record);
+    }
+}
+
+void Prune(std::map<std::string, DbRecord>& records, Stats& stats)
+{
+    const auto& validators = miopen::solver::GetPerfDbValidators();
+
+    for(auto record = records.begin(); record != records.end();)
+    {
+        ConvolutionContext problem;
+        const auto is_key_valid = problem.Deserialize(record->first);
+        std::vector<std::string> pruned_ids;
+
+        for(const auto& pair : record->second.GetContents())
+        {
+            const auto validator = validators.find(pair.first);
+
+            if(validator == validators.end())
+                ++stats.unknown_ids;
+            else if(!validator->second)
+                ++stats.not_searchable_ids;
+            else if(!is_key_valid)
+                ++stats.ill_formed_keys;
+            else if(!validator->second(problem, pair.second))
+                ++stats.invalid_values;
+            else
+                continue;
+
+            pruned_ids.push_back(pair.first);
+        }
+
+        for(const auto& id : pruned_ids)
+            record->second.EraseValues(id);
+
+        record = record->second.GetContents().empty() ? records.erase(record) : std::next(record);
+    }
+}
+
+void Write(const std::string& path, const std::map<std::string, DbRecord>& records)
+{
+    std::ofstream file(path);
+
+    for(const auto& record : records)
+        record.second.WriteContents(file);
+
+    file.close();
+
+    if(!file)
+    {
+        std::cerr << "Error: unable to write " << path << std::endl;
+        std::exit(1);
+    }
+}
+
+void PrintStats(const Stats& stats, std::size_t n_files, bool prune)
+{
+    std::cout << "Files read: " << n_files << std::endl;
+    std::cout << "Lines read: " << stats.lines.lines << std::endl;
+    std::cout << "  ill-formed: " << stats.lines.ill_formed + stats.ill_formed_contents
+              << std::endl;
+    std::cout << "  overridden by a later line: " << stats.lines.overridden << std::endl;
+    std::cout << "  removals: " << stats.lines.removals << std::endl;
+    std::cout << "Conflicting values (the first one kept): " << stats.conflicts << std::endl;
+    std::cout << (prune ? "Pruned values:" : "Values to prune:") << std::endl;
+    std::cout << "  unknown solver: " << stats.unknown_ids << std::endl;
+    std::cout << "  solver is not searchable: " << stats.not_searchable_ids << std::endl;
+    std::cout << "  ill-formed problem config: " << stats.ill_formed_keys << std::endl;
+    std::cout << "  invalid for the solver: " << stats.invalid_values << std::endl;
+    std::cout << "Records: " << stats.records << ", values: " << stats.values << std::endl;
+}
+
+void PrintHelp()
+{
+    std::cout << "Usage: MIOpenPerfDbTool {<option>} <db> {<db>}" << std::endl;
+    std::cout << "Merges text perf dbs (*.cd.pdb.txt) and prints statistics. Values of the dbs "
+                 "listed first win."
+              << std::endl;
+    std::cout << "Duplicate, removed and ill-formed lines are dropped from the result."
+              << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "-o[utput] <path>: db to write the result to. Only statistics are printed if "
+                 "omitted."
+              << std::endl;
+    std::cout << "-p[rune]: removes values of unknown or not searchable solvers and values the "
+                 "solvers consider invalid."
+              << std::endl;
+    std::cout << "-h[elp]: prints this help." << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+} // namespace
+
+int main(int argsn, char** args)
+{
+    std::string output;
+    std::vector<std::string> inputs;
+    auto prune = false;
+
+    for(int i = 1; i < argsn; ++i)
+    {
+        const std::string arg = args[i];
+
+        if(arg.empty() || arg[0] != '-')
+        {
+            inputs.push_back(arg);
+            continue;
+        }
+
+        auto option = arg.substr(1);
+        std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+
+        if(option == "o" || option == "output")
+        {
+            if(i + 1 >= argsn)
+                WrongUsage("value is missing for " + option);
+            output = args[++i];
+        }
+        else if(option == "p" || option == "prune")
+        {
+            prune = true;
+        }
+        else if(option == "h" || option == "help")
+        {
+            PrintHelp();
+            return 0;
+        }
+        else
+        {
+            WrongUsage("unknown argument - " + option);
+        }
+    }
+
+    if(inputs.empty())
+        WrongUsage("no dbs given");
+
+    Stats stats;
+    std::map<std::string, DbRecord> records;
+
+    for(const auto& input : inputs)
+        MergeDb(input, records, stats);
+
+    // Statistics of what would be pruned are collected on a copy, so that the result is
+    // written as is.
+    if(prune)
+    {
+        Prune(records, stats);
+    }
+    else
+    {
+        auto copy = records;
+        Prune(copy, stats);
+    }
+
+    stats.records = records.size();
+    for(const auto& record : records)
+        stats.values += record.second.GetContents().size();
+
+    if(!output.empty())
+        Write(output, records);
+
+    PrintStats(stats, inputs.size(), prune);
+    return 0;
+}
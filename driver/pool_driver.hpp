@@ -72,6 +72,7 @@ class PoolDriver : public Driver
     int AllocateBuffersAndCopy();
 
     int RunForwardGPU();
+    int PrecompileForward(miopenHandle_t precompile_handle);
     int RunForwardCPU(); // Verify implements it
 
     int RunBackwardGPU();
@@ -312,6 +313,13 @@ int PoolDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
     return miopenStatusSuccess;
 }
 
+template <typename Tgpu, typename Tref>
+int PoolDriver<Tgpu, Tref>::PrecompileForward(miopenHandle_t precompile_handle)
+{
+    return miopenPrecompilePoolingForward(
+        precompile_handle, poolDesc, inputTensor, outputTensor, do_backward);
+}
+
 template <typename Tgpu, typename Tref>
 int PoolDriver<Tgpu, Tref>::RunForwardGPU()
 {
@@ -0,0 +1,141 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_PRECOMPILE_DRIVER_HPP
+#define GUARD_MIOPEN_PRECOMPILE_DRIVER_HPP
+
+#include "InputFlags.hpp"
+#include "driver.hpp"
+#include "timer.hpp"
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <miopen/miopen.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Splits a layer line into MIOpenDriver arguments. Anything up to the MIOpenDriver executable is
+// skipped, so the lines logged with MIOPEN_ENABLE_LOGGING_CMD can be used as they are.
+std::vector<std::string> GetLayerArgs(const std::string& line)
+{
+    std::vector<std::string> args;
+    std::istringstream ss(line);
+    std::string arg;
+    while(ss >> arg)
+    {
+        const std::string exe = "MIOpenDriver";
+        if(arg.size() >= exe.size() && arg.compare(arg.size() - exe.size(), exe.size(), exe) == 0)
+            args.clear();
+        else
+            args.push_back(arg);
+    }
+    return args;
+}
+
+// Compiles the kernels of all the layers listed in a file, one MIOpenDriver command per line,
+// into the kernel cache, without running the layers.
+template <class MakeDriver>
+int RunPrecompile(int argc, char* argv[], MakeDriver make_driver)
+{
+    InputFlags inflags;
+    inflags.AddInputFlag("layers",
+                         'i',
+                         "",
+                         "File with one MIOpenDriver command per layer, e.g. conv -n 1 -c 3 ...",
+                         "string");
+    inflags.Parse(argc, argv);
+
+    const auto layers_path = inflags.GetValueStr("layers");
+    std::ifstream layers(layers_path);
+    if(!layers)
+    {
+        std::cerr << "Cannot open the layer list: " << layers_path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    miopenHandle_t handle;
+#if MIOPEN_BACKEND_OPENCL
+    miopenCreate(&handle);
+#elif MIOPEN_BACKEND_HIP
+    hipStream_t s;
+    hipStreamCreate(&s);
+    miopenCreateWithStream(&handle, s);
+#endif
+
+    Timer t;
+    t.start();
+
+    int n_layers  = 0;
+    int n_skipped = 0;
+    std::string line;
+    while(std::getline(layers, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+        auto args = GetLayerArgs(line);
+        if(args.empty())
+            continue;
+
+        std::unique_ptr<Driver> drv{make_driver(args[0])};
+        auto status = miopenStatusNotImplemented;
+        if(drv != nullptr)
+        {
+            std::vector<char*> layer_argv{argv[0]};
+            for(auto& arg : args)
+                layer_argv.push_back(&arg[0]);
+
+            drv->AddCmdLineArgs();
+            drv->ParseCmdLineArgs(static_cast<int>(layer_argv.size()), layer_argv.data());
+            drv->GetandSetData();
+            status = static_cast<miopenStatus_t>(drv->PrecompileForward(handle));
+        }
+
+        if(status == miopenStatusSuccess)
+        {
+            std::cout << "Precompiling: " << line << std::endl;
+            ++n_layers;
+        }
+        else
+        {
+            std::cout << "Skipped (status " << status << "): " << line << std::endl;
+            ++n_skipped;
+        }
+    }
+
+    std::size_t n_built  = 0;
+    std::size_t n_failed = 0;
+    miopenWaitForPrecompiled(handle, &n_built, &n_failed);
+    miopenDestroy(handle);
+    t.stop();
+
+    std::cout << "Layers: " << n_layers << ", skipped: " << n_skipped << std::endl;
+    std::cout << "Programs built or found in the cache: " << n_built << ", failed: " << n_failed
+              << std::endl;
+    std::cout << "Time: " << t.gettime_ms() << " ms" << std::endl;
+    return n_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // GUARD_MIOPEN_PRECOMPILE_DRIVER_HPP
@@ -67,6 +67,7 @@ class SoftmaxDriver : public Driver
     int AllocateBuffersAndCopy();
 
     int RunForwardGPU();
+    int PrecompileForward(miopenHandle_t precompile_handle);
     int RunForwardCPU();
 
     int RunBackwardGPU();
@@ -218,6 +219,12 @@ int SoftmaxDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
     return miopenStatusSuccess;
 }
 
+template <typename Tgpu, typename Tref>
+int SoftmaxDriver<Tgpu, Tref>::PrecompileForward(miopenHandle_t precompile_handle)
+{
+    return miopenPrecompileSoftmaxForward(precompile_handle, inputTensor, outputTensor);
+}
+
 template <typename Tgpu, typename Tref>
 int SoftmaxDriver<Tgpu, Tref>::RunForwardGPU()
 {
@@ -194,6 +194,64 @@ MIOPEN_EXPORT miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
                                                 miopenDeallocatorFunction deallocator,
                                                 void* allocatorContext);
 
+/*! @brief Statistics of the buffers that a handle allocates for itself
+ */
+typedef struct
+{
+    size_t inUseSize;  /*!< Bytes of the buffers in use */
+    size_t cachedSize; /*!< Bytes of the released buffers kept for reuse */
+    size_t peakSize;   /*!< Most bytes held at once, in use or kept for reuse */
+    size_t hitCount;   /*!< Allocations that reused a released buffer */
+    size_t missCount;  /*!< Allocations made with the allocator */
+} miopenMemoryPoolStats_t;
+
+/*! @brief Set how many bytes of released buffers a handle keeps for reuse
+ *
+ * The buffers that MIOpen allocates for itself, e.g. while searching for the best convolution
+ * algorithm, are kept once released and reused by later allocations of the same size class.
+ * miopenSetAllocator() resets the capacity: the buffers of the default allocator are kept up to a
+ * quarter of the device memory, unless the MIOPEN_DEBUG_MEMORY_POOL environment variable is set to
+ * 0, and those of a custom allocator are not kept. Call this function after miopenSetAllocator()
+ * to also keep the buffers of a custom allocator, which then allocates whole size classes.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param capacity   Bytes kept at most, SIZE_MAX for no limit; 0 frees buffers once released
+ *                   (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetMemoryPoolCapacity(miopenHandle_t handle, size_t capacity);
+
+/*! @brief Free the released buffers that a handle keeps for reuse
+ *
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenTrimMemoryPool(miopenHandle_t handle);
+
+/*! @brief Get the statistics of the buffers that a handle allocates for itself
+ *
+ * @param handle     MIOpen handle (input)
+ * @param stats      Statistics of the buffers (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetMemoryPoolStats(miopenHandle_t handle,
+                                                      miopenMemoryPoolStats_t* stats);
+
+/*! @brief Enable the workspace arena of a handle
+ *
+ * Lets the convolution functions and miopenRNNForwardInference() use a workspace of the handle
+ * when they are given a NULL workspace. The workspace is sized as returned by the matching
+ * GetWorkSpaceSize function, up to the limit, so the miopenFindConvolution*Algorithm() functions
+ * also consider the algorithms that need a workspace. The handle keeps one buffer for these
+ * workspaces, grown to the largest size needed so far.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param sizeLimit  Bytes of the buffer at most, SIZE_MAX for no limit; 0 disables the arena
+ *                   (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableWorkspaceArena(miopenHandle_t handle, size_t sizeLimit);
+
 /*! @brief Get time for last kernel launched
  *
  * This function is used only when profiling mode has been enabled.
@@ -215,6 +273,95 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Kernel launch recorded by the kernel trace of a handle
+ *
+ * Times are in nanoseconds of the device clock, 0 if the queue of the handle does not profile.
+ */
+typedef struct
+{
+    char kernelName[128];          /*!< Name of the kernel function */
+    char networkConfig[256];       /*!< Problem the kernel is used for, truncated if longer */
+    unsigned long long queuedTime; /*!< Time the launch has been queued */
+    unsigned long long startTime;  /*!< Time the kernel has started */
+    unsigned long long endTime;    /*!< Time the kernel has ended */
+} miopenKernelTraceEntry_t;
+
+/*! @brief Enable the kernel trace
+ *
+ * Records the last launches of kernels made with the handle, with their times. Unlike
+ * miopenEnableProfiling(), this does not wait for each kernel: their times are read by
+ * miopenGetKernelTrace() and miopenDumpKernelTrace(). Not supported with HIP.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param capacity   Number of launches kept, the oldest ones are dropped; 0 disables the trace
+ *                   and drops it (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableKernelTrace(miopenHandle_t handle, size_t capacity);
+
+/*! @brief Get the launches of the kernel trace
+ *
+ * Waits for the kernels of the trace and copies the launches, oldest first.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param entries    Array of *count entries, or NULL to get the number of launches (output)
+ * @param count      Size of the array on input, number of launches copied on output, or
+ *                   number of launches of the trace if entries is NULL (input/output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetKernelTrace(miopenHandle_t handle,
+                                                  miopenKernelTraceEntry_t* entries,
+                                                  size_t* count);
+
+/*! @brief Write the kernel trace to a file
+ *
+ * Waits for the kernels of the trace and writes the launches in the Chrome trace event format,
+ * which chrome://tracing displays.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param fileName   Path of the JSON file (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenDumpKernelTrace(miopenHandle_t handle, const char* fileName);
+
+/*! @brief Wait for the kernels compiled ahead of time
+ *
+ * Waits for the kernels started by the miopenPrecompile*() functions on the handle, e.g.
+ * miopenPrecompileConvolutionForward(). Once they are built, they are stored in the kernel cache,
+ * so a process running the same layers later does not compile them. This makes it possible to
+ * fill the kernel cache before the first run of a network, e.g. when a container image is built.
+ *
+ * @param handle       MIOpen handle (input)
+ * @param builtCount   Number of programs built or loaded from the kernel cache (output)
+ * @param failedCount  Number of programs that failed to build (output)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenWaitForPrecompiled(miopenHandle_t handle,
+                                                      size_t* builtCount,
+                                                      size_t* failedCount);
+
+/*! @brief Statistics of the kernel cache of the process
+ */
+typedef struct
+{
+    size_t hitCount;           /*!< Binaries loaded from the cache */
+    size_t missCount;          /*!< Binaries looked for but not found, so compiled */
+    size_t bytesRead;          /*!< Sizes of the binaries loaded */
+    size_t compileTimeAvoided; /*!< Compilation times of the binaries loaded, in ms */
+    size_t evictionCount;      /*!< Binaries removed to keep the cache within its size limit */
+    size_t bytesEvicted;       /*!< Sizes of the binaries removed */
+} miopenBinaryCacheStats_t;
+
+/*! @brief Get the statistics of the kernel cache
+ *
+ * The statistics are those of the whole process, i.e. of all the handles, since it started.
+ * They are all zero if the cache is disabled.
+ *
+ * @param stats      Statistics of the cache (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetBinaryCacheStats(miopenBinaryCacheStats_t* stats);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -774,6 +921,27 @@ MIOPEN_EXPORT miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
                                                       void* workSpace,
                                                       size_t workSpaceSize);
 
+/*! @brief Compile the kernels of a forward convolution ahead of time
+ *
+ * Starts compiling, in background threads, the kernels of the convolution algorithms that
+ * miopenFindConvolutionForwardAlgorithm() would try. The solutions are taken from the performance
+ * database or the heuristics, nothing is benchmarked and no kernel is launched. The compiled
+ * kernels are stored in the kernel cache. Call miopenWaitForPrecompiled() to wait for them.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenPrecompileConvolutionForward(miopenHandle_t handle,
+                                   const miopenTensorDescriptor_t xDesc,
+                                   const miopenTensorDescriptor_t wDesc,
+                                   const miopenConvolutionDescriptor_t convDesc,
+                                   const miopenTensorDescriptor_t yDesc);
+
 /*! @brief Calculate element-wise scale and shift of a tensor via a bias tensor
  *
  *  This function applies an element-wise bias to a data tensor from an input bias tensor.
@@ -1171,6 +1339,25 @@ MIOPEN_EXPORT miopenStatus_t miopenPoolingForward(miopenHandle_t handle,
                                                   void* workSpace,
                                                   size_t workSpaceSize);
 
+/*! @brief Compile the kernels of a forward pooling layer ahead of time
+ *
+ * Starts compiling, in background threads, the kernels miopenPoolingForward() would use,
+ * without running the layer. Call miopenWaitForPrecompiled() to wait for them.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param poolDesc       Descriptor for pooling layer (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param do_backward    Boolean to toggle save data in workspace for backwards pass (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenPrecompilePoolingForward(miopenHandle_t handle,
+                               const miopenPoolingDescriptor_t poolDesc,
+                               const miopenTensorDescriptor_t xDesc,
+                               const miopenTensorDescriptor_t yDesc,
+                               bool do_backward);
+
 /*! @brief Execute a backward pooling layer
  *
  * Runs backward pooling. miopenPoolingGetWorkSpaceSize() must be called before
@@ -1307,6 +1494,24 @@ MIOPEN_EXPORT miopenStatus_t miopenLRNForward(miopenHandle_t handle,
                                               bool do_backward,
                                               void* workSpace);
 
+/*! @brief Compile the kernels of a forward LRN layer ahead of time
+ *
+ * Starts compiling, in background threads, the kernels miopenLRNForward() would use,
+ * without running the layer. Call miopenWaitForPrecompiled() to wait for them.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param lrnDesc        LRN layer descriptor (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param do_backward    Boolean to toggle save data in workspace for backwards pass (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenPrecompileLRNForward(miopenHandle_t handle,
+                                                        const miopenLRNDescriptor_t lrnDesc,
+                                                        const miopenTensorDescriptor_t xDesc,
+                                                        const miopenTensorDescriptor_t yDesc,
+                                                        bool do_backward);
+
 /*! @brief Execute a LRN backward layer
  *
  * @param handle         MIOpen handle (input)
@@ -1470,6 +1675,27 @@ miopenBatchNormalizationForwardInference(miopenHandle_t handle,
                                          void* estimatedVariance,
                                          double epsilon);
 
+/*! @brief Compile the kernels of a forward inference batch normalization ahead of time
+ *
+ * Starts compiling, in background threads, the kernels
+ * miopenBatchNormalizationForwardInference() would use with the estimated mean and variance,
+ * without running the layer. Call miopenWaitForPrecompiled() to wait for them.
+ *
+ * @param handle                    MIOpen handle (input)
+ * @param bn_mode                   Batch normalization mode (input)
+ * @param xDesc                     Tensor descriptor for data input tensor x (input)
+ * @param yDesc                     Tensor descriptor for output data tensor y (input)
+ * @param bnScaleBiasMeanVarDesc    Tensor descriptor for BN scaling, shifting, saved variance and
+ * mean (input)
+ * @return                          miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenPrecompileBatchNormalizationForwardInference(
+    miopenHandle_t handle,
+    miopenBatchNormMode_t bn_mode,
+    const miopenTensorDescriptor_t xDesc,
+    const miopenTensorDescriptor_t yDesc,
+    const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc);
+
 /*! @brief Execute backwards propagation layer for batch normalization
  *
  * Batch normalization pass for backwards propagation training pass.
@@ -1598,6 +1824,23 @@ MIOPEN_EXPORT miopenStatus_t miopenActivationForward(miopenHandle_t handle,
                                                      const miopenTensorDescriptor_t yDesc,
                                                      void* y);
 
+/*! @brief Compile the kernels of a forward activation layer ahead of time
+ *
+ * Starts compiling, in background threads, the kernels miopenActivationForward() would use,
+ * without running the layer. Call miopenWaitForPrecompiled() to wait for them.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param activDesc      Activation layer descriptor (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenPrecompileActivationForward(miopenHandle_t handle,
+                                  const miopenActivationDescriptor_t activDesc,
+                                  const miopenTensorDescriptor_t xDesc,
+                                  const miopenTensorDescriptor_t yDesc);
+
 /*! @brief Execute a activation backwards layer
  *
  * @param handle         MIOpen handle (input)
@@ -1664,6 +1907,20 @@ MIOPEN_EXPORT miopenStatus_t miopenSoftmaxForward(miopenHandle_t handle,
                                                   const miopenTensorDescriptor_t yDesc,
                                                   void* y);
 
+/*! @brief Compile the kernels of a softmax forward layer ahead of time
+ *
+ * Starts compiling, in background threads, the kernels miopenSoftmaxForward() would use,
+ * without running the layer. Call miopenWaitForPrecompiled() to wait for them.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenPrecompileSoftmaxForward(miopenHandle_t handle,
+                                                            const miopenTensorDescriptor_t xDesc,
+                                                            const miopenTensorDescriptor_t yDesc);
+
 /*! @brief Execute a softmax backwards layer
  *
  * MIOpen does not support Softmax modes. MIOpen implements the SOFTMAX_MODE_CHANNEL flavor.
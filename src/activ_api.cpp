@@ -27,6 +27,7 @@
 #include <initializer_list>
 #include <miopen/activ.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 
 extern "C" miopenStatus_t miopenCreateActivationDescriptor(miopenActivationDescriptor_t* activDesc)
@@ -88,6 +89,28 @@ extern "C" miopenStatus_t miopenActivationForward(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenPrecompileActivationForward(miopenHandle_t handle,
+                                  const miopenActivationDescriptor_t activDesc,
+                                  const miopenTensorDescriptor_t xDesc,
+                                  const miopenTensorDescriptor_t yDesc)
+{
+
+    MIOPEN_LOG_FUNCTION(activDesc, xDesc, yDesc);
+    return miopen::try_([&] {
+        miopen::AutoPrecompileOnly precompile_only{miopen::deref(handle)};
+        const float alpha = 1;
+        const float beta  = 0;
+        miopen::deref(activDesc).Forward(miopen::deref(handle),
+                                         &alpha,
+                                         miopen::deref(xDesc),
+                                         precompile_only.GetBuffer(),
+                                         &beta,
+                                         miopen::deref(yDesc),
+                                         precompile_only.GetBuffer());
+    });
+}
+
 extern "C" miopenStatus_t miopenActivationBackward(miopenHandle_t handle,
                                                    miopenActivationDescriptor_t activDesc,
                                                    const void* alpha,
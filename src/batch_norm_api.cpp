@@ -27,6 +27,7 @@
 #include <initializer_list>
 #include <miopen/batch_norm.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/tensor_ops.hpp>
@@ -88,6 +89,36 @@ miopenBatchNormalizationForwardInference(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t miopenPrecompileBatchNormalizationForwardInference(
+    miopenHandle_t handle,
+    miopenBatchNormMode_t bn_mode,
+    const miopenTensorDescriptor_t xDesc,
+    const miopenTensorDescriptor_t yDesc,
+    const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc)
+{
+    MIOPEN_LOG_FUNCTION(bn_mode, xDesc, yDesc, bnScaleBiasMeanVarDesc);
+    return miopen::try_([&] {
+        miopen::AutoPrecompileOnly precompile_only{miopen::deref(handle)};
+        const auto buffer = precompile_only.GetBuffer();
+        float alpha       = 1;
+        float beta        = 0;
+        miopen::BatchNormForwardInference(miopen::deref(handle),
+                                          bn_mode,
+                                          &alpha,
+                                          &beta,
+                                          miopen::deref(xDesc),
+                                          buffer,
+                                          miopen::deref(yDesc),
+                                          buffer,
+                                          miopen::deref(bnScaleBiasMeanVarDesc),
+                                          buffer,
+                                          buffer,
+                                          buffer,
+                                          buffer,
+                                          0);
+    });
+}
+
 extern "C" miopenStatus_t
 miopenBatchNormalizationForwardTraining(miopenHandle_t handle,
                                         miopenBatchNormMode_t bn_mode,
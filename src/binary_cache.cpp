@@ -28,16 +28,30 @@
 #include <miopen/md5.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/env.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/miopen.h>
 #include <miopen/version.h>
 #include <boost/filesystem.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cctype>
+#include <cstring>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CACHE_SIZE_LIMIT_MB)
 
 boost::filesystem::path ComputeCachePath()
 {
@@ -72,13 +86,466 @@ bool IsCacheDisabled()
 #endif
 }
 
+namespace {
+
+constexpr std::size_t key_hash_size = 32; // md5 in hex
+
+struct IndexEntry
+{
+    char key_hash[key_hash_size];
+    std::uint64_t offset; // of the DataHeader
+    std::uint64_t size;
+    std::uint64_t last_used;    // seconds since the epoch
+    std::uint64_t compile_time; // ms
+};
+
+struct DataHeader
+{
+    char key_hash[key_hash_size];
+    std::uint64_t size;
+};
+
+static_assert(sizeof(IndexEntry) == 64, "Index entries shall have no padding");
+static_assert(sizeof(DataHeader) == 40, "Data headers shall have no padding");
+
+// Last use is written back to the index no more often, to keep hits cheap.
+constexpr std::uint64_t last_used_resolution = 60 * 60;
+
+std::uint64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+std::string GetCacheKey(const std::string& device,
+                        const std::string& name,
+                        const std::string& args,
+                        bool is_kernel_str)
+{
+    std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
+    return miopen::md5(device + ":" + args) + "/" + filename;
+}
+
+std::uint64_t GetCacheSizeLimit()
+{
+    // In MiB, 0 means no limit.
+    const auto env = GetStringEnv(MIOPEN_CACHE_SIZE_LIMIT_MB{});
+    const std::uint64_t limit =
+        env == nullptr ? MIOPEN_DEFAULT_CACHE_SIZE_LIMIT_MB : Value(MIOPEN_CACHE_SIZE_LIMIT_MB{});
+    return limit * 1024 * 1024;
+}
+
+std::uint64_t GetDirectorySize(const boost::filesystem::path& dir)
+{
+    std::uint64_t size = 0;
+    boost::system::error_code error;
+    for(boost::filesystem::recursive_directory_iterator it(dir, error), end; it != end;
+        it.increment(error))
+    {
+        if(!error && boost::filesystem::is_regular_file(it->status()))
+            size += boost::filesystem::file_size(it->path(), error);
+    }
+    return size;
+}
+
+bool IsVersion(const std::string& name)
+{
+    return std::count(name.begin(), name.end(), '.') == 2 &&
+           std::all_of(name.begin(), name.end(), [](char c) {
+               return c == '.' || std::isdigit(static_cast<unsigned char>(c));
+           });
+}
+
+// Caches of other MIOpen versions are never used by this one. They are removed, least recently
+// written first, while the whole cache exceeds the limit.
+void RemoveOtherVersions(const boost::filesystem::path& cache_path, std::uint64_t size_limit)
+{
+    if(size_limit == 0 || cache_path.empty())
+        return;
+
+    boost::system::error_code error;
+    std::vector<std::pair<std::time_t, boost::filesystem::path>> others;
+    std::uint64_t total_size = 0;
+
+    for(boost::filesystem::directory_iterator it(cache_path.parent_path(), error), end;
+        it != end;
+        it.increment(error))
+    {
+        if(error || it->path() == cache_path || !boost::filesystem::is_directory(it->status()) ||
+           !IsVersion(it->path().filename().string()))
+            continue;
+        others.emplace_back(boost::filesystem::last_write_time(it->path(), error), it->path());
+        total_size += GetDirectorySize(it->path());
+    }
+
+    if(others.empty())
+        return;
+
+    total_size += GetDirectorySize(cache_path);
+    std::sort(others.begin(), others.end());
+
+    for(const auto& other : others)
+    {
+        if(total_size <= size_limit)
+            break;
+        const auto size = GetDirectorySize(other.second);
+        MIOPEN_LOG_I("Removing the binary cache of another version: " << other.second);
+        boost::filesystem::remove_all(other.second, error);
+        if(!error)
+            total_size -= std::min(size, total_size);
+    }
+}
+
+void LogStats(const BinaryCacheStats& stats)
+{
+    if(stats.hits + stats.misses == 0)
+        return;
+    MIOPEN_LOG_I("Binary cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+                                  << stats.bytes_read
+                                  << " bytes read, "
+                                  << stats.compile_time_avoided
+                                  << " ms of compilation avoided, "
+                                  << stats.evictions
+                                  << " binaries ("
+                                  << stats.bytes_evicted
+                                  << " bytes) evicted");
+}
+
+struct CacheArchive
+{
+    BinaryArchive archive;
+
+    CacheArchive() : archive(GetCachePath(), GetCacheSizeLimit())
+    {
+        try
+        {
+            RemoveOtherVersions(GetCachePath(), GetCacheSizeLimit());
+        }
+        catch(const boost::filesystem::filesystem_error& ex)
+        {
+            MIOPEN_LOG_W("Unable to remove caches of other versions: " << ex.what());
+        }
+    }
+
+    ~CacheArchive() { LogStats(archive.GetStats()); }
+};
+
+BinaryArchive& GetArchive()
+{
+    static CacheArchive cache;
+    return cache.archive;
+}
+
+} // namespace
+
+BinaryArchive::BinaryArchive(const boost::filesystem::path& directory, std::uint64_t size_limit_)
+    : data_path(directory / "binaries.dat"),
+      index_path(directory / "binaries.idx"),
+      lock_path(directory / "binaries.lock"),
+      size_limit(size_limit_)
+{
+}
+
+void BinaryArchive::ReadIndexUnsafe()
+{
+    std::ifstream file(index_path.string(), std::ios::binary);
+    if(!file)
+        return;
+
+    // The index was replaced by a compaction.
+    file.seekg(0, std::ios::end);
+    if(static_cast<std::uint64_t>(file.tellg()) < index_read)
+        ResetUnsafe();
+
+    file.seekg(index_read);
+    IndexEntry entry;
+
+    // A partially written last entry fails to read and is read again later.
+    while(file.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+    {
+        index[std::string(entry.key_hash, key_hash_size)] = {
+            entry.offset, entry.size, entry.last_used, entry.compile_time, index_read};
+        index_read += sizeof(entry);
+    }
+}
+
+void BinaryArchive::ResetUnsafe()
+{
+    index.clear();
+    index_read = 0;
+    data       = boost::interprocess::mapped_region();
+}
+
+bool BinaryArchive::MapDataUnsafe(std::uint64_t size)
+{
+    if(data.get_size() >= size)
+        return true;
+
+    // The file only grows until it is replaced, so the old mapping stays valid for the binaries
+    // already loaded.
+    try
+    {
+        data_file = boost::interprocess::file_mapping(data_path.c_str(),
+                                                      boost::interprocess::read_only);
+        data = boost::interprocess::mapped_region(data_file, boost::interprocess::read_only);
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map " << data_path << ": " << ex.what());
+        return false;
+    }
+
+    return data.get_size() >= size;
+}
+
+boost::optional<std::string> BinaryArchive::ReadBinaryUnsafe(const std::string& key_hash,
+                                                              bool& stale)
+{
+    auto it = index.find(key_hash);
+    if(it == index.end())
+    {
+        ReadIndexUnsafe();
+        it = index.find(key_hash);
+        if(it == index.end())
+            return boost::none;
+    }
+
+    auto& location = it->second;
+    if(!MapDataUnsafe(location.offset + sizeof(DataHeader) + location.size))
+    {
+        stale = true;
+        return boost::none;
+    }
+
+    const auto begin = static_cast<const char*>(data.get_address()) + location.offset;
+    DataHeader header;
+    std::memcpy(&header, begin, sizeof(header));
+
+    if(header.size != location.size ||
+       std::memcmp(header.key_hash, key_hash.data(), key_hash_size) != 0)
+    {
+        stale = true;
+        return boost::none;
+    }
+
+    TouchUnsafe(key_hash, location);
+    ++stats.hits;
+    stats.bytes_read += location.size;
+    stats.compile_time_avoided += location.compile_time;
+    return std::string(begin + sizeof(header), begin + sizeof(header) + location.size);
+}
+
+void BinaryArchive::TouchUnsafe(const std::string& key_hash, Location& location)
+{
+    const auto now = Now();
+    if(now < location.last_used + last_used_resolution)
+        return;
+
+    location.last_used = now;
+
+    try
+    {
+        std::lock_guard<LockFile> lock(LockFile::Get(lock_path.c_str()));
+        std::fstream file(index_path.string(), std::ios::binary | std::ios::in | std::ios::out);
+        char entry_key_hash[key_hash_size];
+
+        // The index may have been replaced by a compaction since it was read.
+        file.seekg(location.position + offsetof(IndexEntry, key_hash));
+        if(!file.read(entry_key_hash, key_hash_size) ||
+           std::memcmp(entry_key_hash, key_hash.data(), key_hash_size) != 0)
+            return;
+
+        file.seekp(location.position + offsetof(IndexEntry, last_used));
+        file.write(reinterpret_cast<const char*>(&now), sizeof(now));
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to lock " << lock_path << ": " << ex.what());
+    }
+    catch(const boost::filesystem::filesystem_error& ex)
+    {
+        MIOPEN_LOG_W("Unable to lock " << lock_path << ": " << ex.what());
+    }
+}
+
+boost::optional<std::string> BinaryArchive::Load(const std::string& key)
+{
+    const auto key_hash = miopen::md5(key);
+    std::lock_guard<std::mutex> guard(mutex);
+
+    auto stale  = false;
+    auto binary = ReadBinaryUnsafe(key_hash, stale);
+
+    // The files may have been replaced by a compaction since the index was read.
+    if(stale)
+    {
+        MIOPEN_LOG_I2("Binary cache was compacted, reading the index again");
+        ResetUnsafe();
+        binary = ReadBinaryUnsafe(key_hash, stale);
+    }
+
+    if(!binary)
+        ++stats.misses;
+    return binary;
+}
+
+bool BinaryArchive::Save(const std::string& key,
+                         const std::string& binary,
+                         std::uint64_t compile_time)
+{
+    const auto key_hash = miopen::md5(key);
+    std::lock_guard<std::mutex> guard(mutex);
+
+    try
+    {
+        std::lock_guard<LockFile> lock(LockFile::Get(lock_path.c_str()));
+
+        IndexEntry entry;
+        std::memcpy(entry.key_hash, key_hash.data(), key_hash_size);
+        entry.offset =
+            boost::filesystem::exists(data_path) ? boost::filesystem::file_size(data_path) : 0;
+        entry.size         = binary.size();
+        entry.last_used    = Now();
+        entry.compile_time = compile_time;
+
+        {
+            DataHeader header;
+            std::memcpy(header.key_hash, key_hash.data(), key_hash_size);
+            header.size = binary.size();
+
+            std::ofstream file(data_path.string(), std::ios::binary | std::ios::app);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), binary.size());
+            file.close();
+            if(!file)
+            {
+                MIOPEN_LOG_W("Unable to write " << data_path);
+                return false;
+            }
+        }
+
+        // A process which failed in the middle of writing could leave a partial entry.
+        if(boost::filesystem::exists(index_path))
+        {
+            const auto index_size = boost::filesystem::file_size(index_path);
+            if(index_size % sizeof(IndexEntry) != 0)
+                boost::filesystem::resize_file(index_path,
+                                               index_size - index_size % sizeof(IndexEntry));
+        }
+
+        {
+            std::ofstream file(index_path.string(), std::ios::binary | std::ios::app);
+            file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+            file.close();
+            if(!file)
+            {
+                MIOPEN_LOG_W("Unable to write " << index_path);
+                return false;
+            }
+        }
+
+        if(size_limit != 0 && boost::filesystem::file_size(data_path) > size_limit)
+            CompactUnsafe(size_limit / 4 * 3);
+    }
+    catch(const boost::filesystem::filesystem_error& ex)
+    {
+        MIOPEN_LOG_W("Unable to save a binary to the cache: " << ex.what());
+        return false;
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to save a binary to the cache: " << ex.what());
+        return false;
+    }
+
+    ReadIndexUnsafe();
+    return true;
+}
+
+void BinaryArchive::CompactUnsafe(std::uint64_t target_size)
+{
+    ResetUnsafe();
+    ReadIndexUnsafe();
+    if(!MapDataUnsafe(boost::filesystem::file_size(data_path)))
+        return;
+
+    std::vector<std::pair<std::string, Location>> entries(index.begin(), index.end());
+    // Most recently used first, most recently written first among used at the same time.
+    std::sort(entries.begin(), entries.end(), [](const auto& left, const auto& right) {
+        return std::tie(left.second.last_used, left.second.offset) >
+               std::tie(right.second.last_used, right.second.offset);
+    });
+
+    const auto temp_data_path  = data_path.string() + ".tmp";
+    const auto temp_index_path = index_path.string() + ".tmp";
+    std::ofstream data_out(temp_data_path, std::ios::binary | std::ios::trunc);
+    std::ofstream index_out(temp_index_path, std::ios::binary | std::ios::trunc);
+    std::uint64_t size = 0;
+    auto evictions     = stats.evictions;
+    auto bytes_evicted = stats.bytes_evicted;
+
+    for(const auto& kept : entries)
+    {
+        const auto& location = kept.second;
+        const auto record_size = sizeof(DataHeader) + location.size;
+
+        if(size + record_size > target_size ||
+           location.offset + record_size > data.get_size())
+        {
+            ++evictions;
+            bytes_evicted += location.size;
+            continue;
+        }
+
+        IndexEntry entry;
+        std::memcpy(entry.key_hash, kept.first.data(), key_hash_size);
+        entry.offset       = size;
+        entry.size         = location.size;
+        entry.last_used    = location.last_used;
+        entry.compile_time = location.compile_time;
+
+        data_out.write(static_cast<const char*>(data.get_address()) + location.offset,
+                       record_size);
+        index_out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        size += record_size;
+    }
+
+    data_out.close();
+    index_out.close();
+
+    if(!data_out || !index_out)
+    {
+        MIOPEN_LOG_W("Unable to compact " << data_path);
+        boost::filesystem::remove(temp_data_path);
+        boost::filesystem::remove(temp_index_path);
+        return;
+    }
+
+    MIOPEN_LOG_I("Binary cache compacted to " << size << " bytes, "
+                                              << evictions - stats.evictions
+                                              << " binaries evicted");
+    stats.evictions     = evictions;
+    stats.bytes_evicted = bytes_evicted;
+
+    // Readers detect the new data file by the headers, the index is replaced last.
+    boost::filesystem::rename(temp_data_path, data_path);
+    boost::filesystem::rename(temp_index_path, index_path);
+    ResetUnsafe();
+}
+
+BinaryCacheStats BinaryArchive::GetStats()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    return stats;
+}
+
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
                                      bool is_kernel_str)
 {
-    std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
-    return GetCachePath() / miopen::md5(device + ":" + args) / filename;
+    return GetCachePath() / GetCacheKey(device, name, args, is_kernel_str);
 }
 
 std::string LoadBinary(const std::string& device,
@@ -88,32 +555,29 @@ std::string LoadBinary(const std::string& device,
 {
     if(miopen::IsCacheDisabled())
         return {};
-    auto f = GetCacheFile(device, name, args, is_kernel_str);
-    if(boost::filesystem::exists(f))
-    {
-        return f.string();
-    }
-    else
-    {
-        return {};
-    }
+    const auto binary = GetArchive().Load(GetCacheKey(device, name, args, is_kernel_str));
+    return binary ? *binary : std::string{};
 }
+
 void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& device,
                 const std::string& name,
                 const std::string& args,
-                bool is_kernel_str)
+                bool is_kernel_str,
+                std::uint64_t compile_time)
+{
+    if(!miopen::IsCacheDisabled())
+        GetArchive().Save(GetCacheKey(device, name, args, is_kernel_str),
+                          miopen::LoadFile(binary_path.string()),
+                          compile_time);
+    boost::filesystem::remove(binary_path);
+}
+
+BinaryCacheStats GetBinaryCacheStats()
 {
     if(miopen::IsCacheDisabled())
-    {
-        boost::filesystem::remove(binary_path);
-    }
-    else
-    {
-        auto p = GetCacheFile(device, name, args, is_kernel_str);
-        boost::filesystem::create_directories(p.parent_path());
-        boost::filesystem::rename(binary_path, p);
-    }
+        return {};
+    return GetArchive().GetStats();
 }
 
 } // namespace miopen
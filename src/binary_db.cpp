@@ -0,0 +1,222 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_db.hpp>
+#include <miopen/binary_db_format.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/none.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace miopen {
+
+struct BinaryDbFile
+{
+    boost::interprocess::mapped_region region;
+    const binary_db::Entry* entries = nullptr;
+    const char* pool                = nullptr;
+    std::size_t record_count        = 0;
+
+    static std::shared_ptr<const BinaryDbFile> Open(const std::string& filename);
+
+    private:
+    bool Validate(const std::string& filename);
+};
+
+bool BinaryDbFile::Validate(const std::string& filename)
+{
+    const auto size = region.get_size();
+    const auto data = static_cast<const char*>(region.get_address());
+
+    if(size < sizeof(binary_db::Header))
+    {
+        MIOPEN_LOG_E("Binary db is too small: " << filename);
+        return false;
+    }
+
+    binary_db::Header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if(std::memcmp(header.magic, binary_db::Magic(), binary_db::MagicSize) != 0 ||
+       header.version != binary_db::FormatVersion)
+    {
+        MIOPEN_LOG_E("Unsupported binary db format: " << filename);
+        return false;
+    }
+
+    const auto entries_end =
+        header.entries_offset + sizeof(binary_db::Entry) * std::uint64_t{header.record_count};
+
+    if(header.entries_offset % alignof(binary_db::Entry) != 0 || entries_end > size ||
+       header.pool_offset < entries_end || header.pool_offset + header.pool_size > size)
+    {
+        MIOPEN_LOG_E("Binary db is truncated or corrupted: " << filename);
+        return false;
+    }
+
+    entries      = reinterpret_cast<const binary_db::Entry*>(data + header.entries_offset);
+    pool         = data + header.pool_offset;
+    record_count = header.record_count;
+
+    for(std::size_t i = 0; i < record_count; ++i)
+    {
+        const auto& entry = entries[i];
+        if(std::uint64_t{entry.key_offset} + entry.key_size + entry.contents_size >
+           header.pool_size)
+        {
+            MIOPEN_LOG_E("Binary db is truncated or corrupted: " << filename);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<const BinaryDbFile> BinaryDbFile::Open(const std::string& filename)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const BinaryDbFile>> files;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto found = files.find(filename);
+    if(found != files.end())
+        return found->second;
+
+    std::shared_ptr<BinaryDbFile> file;
+
+    boost::system::error_code ec;
+    if(!boost::filesystem::exists(filename, ec) || boost::filesystem::file_size(filename, ec) == 0)
+    {
+        MIOPEN_LOG_I("Binary db not found: " << filename);
+    }
+    else
+    {
+        try
+        {
+            const boost::interprocess::file_mapping mapping(filename.c_str(),
+                                                            boost::interprocess::read_only);
+            file         = std::make_shared<BinaryDbFile>();
+            file->region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+
+            if(!file->Validate(filename))
+                file = nullptr;
+        }
+        catch(const boost::interprocess::interprocess_exception& ex)
+        {
+            MIOPEN_LOG_E("Unable to map binary db: " << filename << ": " << ex.what());
+            file = nullptr;
+        }
+    }
+
+    // Missing and broken files are remembered too, to not retry them on every lookup.
+    files.emplace(filename, file);
+    return file;
+}
+
+BinaryDb::BinaryDb(const std::string& filename_)
+    : filename(filename_), file(BinaryDbFile::Open(filename_))
+{
+}
+
+boost::optional<DbRecord> BinaryDb::FindRecord(const std::string& key) const
+{
+    MIOPEN_LOG_I("Looking for key: " << key);
+
+    if(!file)
+        return boost::none;
+
+    const auto pool   = file->pool;
+    const auto less   = [pool](const binary_db::Entry& entry, const std::string& value) {
+        const auto common = std::min<std::size_t>(entry.key_size, value.size());
+        const auto cmp    = std::memcmp(pool + entry.key_offset, value.data(), common);
+        return cmp < 0 || (cmp == 0 && entry.key_size < value.size());
+    };
+
+    const auto end   = file->entries + file->record_count;
+    const auto found = std::lower_bound(file->entries, end, key, less);
+
+    if(found == end || found->key_size != key.size() ||
+       std::memcmp(pool + found->key_offset, key.data(), key.size()) != 0)
+        return boost::none;
+
+    const auto contents =
+        std::string(pool + found->key_offset + found->key_size, found->contents_size);
+    MIOPEN_LOG_I("Key match: " << key);
+    MIOPEN_LOG_I("Contents found: " << contents);
+
+    DbRecord record(key);
+    if(!record.ParseContents(contents))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename);
+        MIOPEN_LOG_E("Contents: " << contents);
+    }
+    return record;
+}
+
+boost::optional<DbRecord> BinaryDb::FindClosestRecord(const std::string& id,
+                                                      const DbKeyDistance& distance) const
+{
+    if(!file)
+        return boost::none;
+
+    auto best = std::numeric_limits<double>::infinity();
+    boost::optional<DbRecord> closest;
+
+    // Entries are sorted by key, so the first one of equally close keys wins.
+    for(auto entry = file->entries; entry != file->entries + file->record_count; ++entry)
+    {
+        const auto key = std::string(file->pool + entry->key_offset, entry->key_size);
+        const auto d   = distance(key);
+
+        if(!(d < best))
+            continue;
+
+        DbRecord record(key);
+        const auto contents = std::string(file->pool + entry->key_offset + entry->key_size,
+                                          entry->contents_size);
+        if(!record.ParseContents(contents) || record.FindValues(id) == nullptr)
+            continue;
+
+        best    = d;
+        closest = std::move(record);
+    }
+
+    if(closest)
+        MIOPEN_LOG_I("Closest key: " << closest->key << ", distance: " << best);
+    return closest;
+}
+
+} // namespace miopen
@@ -36,7 +36,8 @@ bool checkNumericsImpl(
 
     auto abnormal_d =
         handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
-    handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+    // Small writes are staged, so the kernel does not wait for the host to be done with them.
+    handle.WriteToAsync(&abnormal_h, abnormal_d.get(), sizeof(CheckNumericsResult));
 
     std::string program_name      = "MIOpenCheckNumerics.cl";
     std::string kernel_name       = "MIOpenCheckNumerics";
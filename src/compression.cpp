@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compression.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace miopen {
+
+// Constants of the LZ4 block format.
+static constexpr std::size_t min_match     = 4;
+static constexpr std::size_t max_offset    = 65535;
+static constexpr std::size_t last_literals = 5;  // The block ends with at least 5 literals.
+static constexpr std::size_t match_limit   = 12; // No match starts in the last 12 bytes.
+static constexpr unsigned hash_bits        = 16;
+
+static std::uint32_t Read32(const unsigned char* p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static void WriteLength(std::vector<unsigned char>& dst, std::size_t length)
+{
+    for(; length >= 255; length -= 255)
+        dst.push_back(255);
+    dst.push_back(static_cast<unsigned char>(length));
+}
+
+static void WriteLiterals(std::vector<unsigned char>& dst,
+                          const unsigned char* literals,
+                          std::size_t count,
+                          unsigned char match_token)
+{
+    const auto literals_token = std::min<std::size_t>(count, 15) << 4;
+    dst.push_back(static_cast<unsigned char>(literals_token | match_token));
+    if(count >= 15)
+        WriteLength(dst, count - 15);
+    dst.insert(dst.end(), literals, literals + count);
+}
+
+std::vector<unsigned char> CompressBlock(const char* data, std::size_t size)
+{
+    const auto in = reinterpret_cast<const unsigned char*>(data);
+    std::vector<unsigned char> dst;
+    dst.reserve(size + size / 255 + 16);
+
+    // Last position seen for each hash of 4 bytes.
+    std::vector<std::size_t> table(std::size_t{1} << hash_bits, SIZE_MAX);
+    const auto last_match_start = size > match_limit ? size - match_limit : 0;
+    const auto last_match_end   = size > last_literals ? size - last_literals : 0;
+
+    std::size_t anchor = 0;
+    std::size_t pos    = 0;
+    while(pos < last_match_start)
+    {
+        const auto sequence  = Read32(in + pos);
+        const auto hash      = (sequence * 2654435761u) >> (32 - hash_bits);
+        const auto candidate = table[hash];
+        table[hash]          = pos;
+
+        if(candidate == SIZE_MAX || pos - candidate > max_offset ||
+           Read32(in + candidate) != sequence)
+        {
+            ++pos;
+            continue;
+        }
+
+        auto end = pos + min_match;
+        while(end < last_match_end && in[end] == in[candidate + end - pos])
+            ++end;
+
+        const auto match = end - pos - min_match;
+        WriteLiterals(dst, in + anchor, pos - anchor, std::min<std::size_t>(match, 15));
+        const auto offset = pos - candidate;
+        dst.push_back(static_cast<unsigned char>(offset & 0xff));
+        dst.push_back(static_cast<unsigned char>(offset >> 8));
+        if(match >= 15)
+            WriteLength(dst, match - 15);
+
+        pos    = end;
+        anchor = end;
+    }
+
+    WriteLiterals(dst, in + anchor, size - anchor, 0);
+    return dst;
+}
+
+bool DecompressBlock(const unsigned char* src,
+                     std::size_t src_size,
+                     char* dst,
+                     std::size_t dst_size)
+{
+    std::size_t ip = 0;
+    std::size_t op = 0;
+
+    const auto read_length = [&](std::size_t& length) {
+        unsigned char byte;
+        do
+        {
+            if(ip == src_size)
+                return false;
+            byte = src[ip++];
+            length += byte;
+        } while(byte == 255);
+        return true;
+    };
+
+    while(ip < src_size)
+    {
+        const auto token = src[ip++];
+
+        std::size_t literals = token >> 4;
+        if(literals == 15 && !read_length(literals))
+            return false;
+        if(literals > src_size - ip || literals > dst_size - op)
+            return false;
+        std::memcpy(dst + op, src + ip, literals);
+        ip += literals;
+        op += literals;
+
+        // The last sequence has no match.
+        if(ip == src_size)
+            break;
+
+        if(src_size - ip < 2)
+            return false;
+        const std::size_t offset = src[ip] | (src[ip + 1] << 8);
+        ip += 2;
+        if(offset == 0 || offset > op)
+            return false;
+
+        std::size_t match = token & 15;
+        if(match == 15 && !read_length(match))
+            return false;
+        match += min_match;
+        if(match > dst_size - op)
+            return false;
+        // The match may overlap the bytes it produces.
+        for(std::size_t i = 0; i < match; ++i, ++op)
+            dst[op] = dst[op - offset];
+    }
+    return op == dst_size;
+}
+
+} // namespace miopen
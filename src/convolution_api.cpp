@@ -151,6 +151,13 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
                         workSpaceSize,
                         exhaustiveSearch);
     return miopen::try_([&] {
+        auto arena_workspace =
+            miopen::deref(handle).UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+                return miopen::deref(convDesc).ForwardGetWorkSpaceSize(miopen::deref(handle),
+                                                                       miopen::deref(wDesc),
+                                                                       miopen::deref(xDesc),
+                                                                       miopen::deref(yDesc));
+            });
         miopen::deref(convDesc).FindConvFwdAlgorithm(miopen::deref(handle),
                                                      miopen::deref(xDesc),
                                                      DataCast(x),
@@ -207,6 +214,13 @@ extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
     }
 
     return miopen::try_([&] {
+        auto arena_workspace =
+            miopen::deref(handle).UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+                return miopen::deref(convDesc).ForwardGetWorkSpaceSize(miopen::deref(handle),
+                                                                       miopen::deref(wDesc),
+                                                                       miopen::deref(xDesc),
+                                                                       miopen::deref(yDesc));
+            });
         miopen::deref(convDesc).ConvolutionForward(miopen::deref(handle),
                                                    alpha,
                                                    miopen::deref(xDesc),
@@ -222,6 +236,23 @@ extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenPrecompileConvolutionForward(miopenHandle_t handle,
+                                   const miopenTensorDescriptor_t xDesc,
+                                   const miopenTensorDescriptor_t wDesc,
+                                   const miopenConvolutionDescriptor_t convDesc,
+                                   const miopenTensorDescriptor_t yDesc)
+{
+
+    MIOPEN_LOG_FUNCTION(xDesc, wDesc, convDesc, yDesc);
+    return miopen::try_([&] {
+        miopen::deref(convDesc).PrecompileForward(miopen::deref(handle),
+                                                  miopen::deref(xDesc),
+                                                  miopen::deref(wDesc),
+                                                  miopen::deref(yDesc));
+    });
+}
+
 extern "C" miopenStatus_t miopenConvolutionForwardBias(miopenHandle_t handle,
                                                        const void* alpha,
                                                        const miopenTensorDescriptor_t bDesc,
@@ -279,6 +310,13 @@ miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
                         workSpaceSize,
                         exhaustiveSearch);
     return miopen::try_([&] {
+        auto arena_workspace =
+            miopen::deref(handle).UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+                return miopen::deref(convDesc).BackwardDataGetWorkSpaceSize(miopen::deref(handle),
+                                                                            miopen::deref(wDesc),
+                                                                            miopen::deref(dyDesc),
+                                                                            miopen::deref(dxDesc));
+            });
         miopen::deref(convDesc).FindConvBwdDataAlgorithm(miopen::deref(handle),
                                                          miopen::deref(dyDesc),
                                                          DataCast(dy),
@@ -336,6 +374,13 @@ miopenConvolutionBackwardData(miopenHandle_t handle,
     }
 
     return miopen::try_([&] {
+        auto arena_workspace =
+            miopen::deref(handle).UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+                return miopen::deref(convDesc).BackwardDataGetWorkSpaceSize(miopen::deref(handle),
+                                                                            miopen::deref(wDesc),
+                                                                            miopen::deref(dyDesc),
+                                                                            miopen::deref(dxDesc));
+            });
         miopen::deref(convDesc).ConvolutionBackwardData(miopen::deref(handle),
                                                         alpha,
                                                         miopen::deref(dyDesc),
@@ -443,6 +488,14 @@ miopenFindConvolutionBackwardWeightsAlgorithm(miopenHandle_t handle,
     }
 
     return miopen::try_([&] {
+        auto arena_workspace =
+            miopen::deref(handle).UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+                return miopen::deref(convDesc).ConvolutionBackwardWeightsGetWorkSpaceSize(
+                    miopen::deref(handle),
+                    miopen::deref(dyDesc),
+                    miopen::deref(xDesc),
+                    miopen::deref(dwDesc));
+            });
         miopen::deref(convDesc).FindConvBwdWeightsAlgorithm(miopen::deref(handle),
                                                             miopen::deref(dyDesc),
                                                             DataCast(dy),
@@ -478,6 +531,14 @@ miopenConvolutionBackwardWeights(miopenHandle_t handle,
     MIOPEN_LOG_FUNCTION(
         alpha, dyDesc, dy, xDesc, x, convDesc, algo, beta, dwDesc, dw, workSpace, workSpaceSize);
     return miopen::try_([&] {
+        auto arena_workspace =
+            miopen::deref(handle).UseWorkspaceArena(workSpace, workSpaceSize, [&] {
+                return miopen::deref(convDesc).ConvolutionBackwardWeightsGetWorkSpaceSize(
+                    miopen::deref(handle),
+                    miopen::deref(dyDesc),
+                    miopen::deref(xDesc),
+                    miopen::deref(dwDesc));
+            });
         miopen::deref(convDesc).ConvolutionBackwardWeights(miopen::deref(handle),
                                                            alpha,
                                                            miopen::deref(dyDesc),
@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -36,15 +37,29 @@
 #include <boost/none.hpp>
 #include <boost/optional.hpp>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // __linux__
+
 #include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdio>
+#include <ctime>
 #include <fstream>
 #include <ios>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
@@ -69,11 +84,6 @@ inline static std::string LockFilePath(const boost::filesystem::path& filename_)
     return file.string();
 }
 
-Db::Db(const std::string& filename_)
-    : filename(filename_), lock_file(LockFile::Get(LockFilePath(filename_).c_str()))
-{
-}
-
 template <class TLock>
 inline static void ValidateLock(const TLock& lock)
 {
@@ -102,6 +112,10 @@ inline static shared_lock MakeSharedLock(LockFile& lock_file)
 
 boost::optional<DbRecord> Db::FindRecord(const std::string& key)
 {
+    // Snapshots are replaced atomically, so any of them is complete.
+    if(write_mode == DbWriteMode::Snapshot)
+        return FindRecordUnsafe(key, nullptr);
+
     const auto lock = MakeSharedLock(lock_file);
     return FindRecordUnsafe(key, nullptr);
 }
@@ -136,33 +150,98 @@ bool Db::Remove(const std::string& key, const std::string& id)
     return StoreRecordUnsafe(*record);
 }
 
-boost::optional<DbRecord> Db::FindRecordUnsafe(const std::string& key, RecordPositions* pos)
+bool GetFileStamp(const std::string& filename, FileStamp& stamp)
 {
-    if(pos)
+#ifdef __linux__
+    struct stat st;
+    if(::stat(filename.c_str(), &st) != 0)
+        return false;
+
+    stamp.size       = st.st_size;
+    stamp.mtime      = st.st_mtim.tv_sec;
+    stamp.mtime_nsec = st.st_mtim.tv_nsec;
+    stamp.node       = st.st_ino;
+    return true;
+#else
+    boost::system::error_code ec;
+    stamp.size = boost::filesystem::file_size(filename, ec);
+    if(ec)
+        return false;
+    stamp.mtime = boost::filesystem::last_write_time(filename, ec);
+    return !ec;
+#endif
+}
+
+/// In-memory index of a db file. Maps each KEY to the position of its line in the file
+/// and to its (unparsed) contents. Built once per file and shared by all Db instances of the
+/// process, so a lookup does not have to re-read and re-scan the file.
+///
+/// The last line with a KEY wins and a line with empty contents ("KEY=") removes the KEY.
+/// Lines that do not contribute to the contents of the db are counted as dead, these are
+/// dropped when the file is compacted.
+struct DbIndex
+{
+    struct Entry
     {
-        pos->begin = -1;
-        pos->end   = -1;
+        RecordPositions pos;
+        int n_line = 0;
+        std::string contents;
+    };
+
+    FileStamp stamp;
+    int n_lines            = 0;
+    std::size_t dead_lines = 0;
+    std::unordered_map<std::string, Entry> records;
+
+    void Add(std::string key, Entry entry)
+    {
+        const auto inserted = records.emplace(std::move(key), Entry{});
+        if(!inserted.second)
+            ++dead_lines;
+        inserted.first->second = std::move(entry);
     }
 
-    MIOPEN_LOG_I("Looking for key: " << key);
+    void Remove(const std::string& key)
+    {
+        // The "KEY=" line itself and the line it removes are both dead.
+        dead_lines += 1 + records.erase(key);
+    }
+};
+
+static std::mutex& DbIndicesMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::unordered_map<std::string, std::shared_ptr<DbIndex>>& DbIndices()
+{
+    static std::unordered_map<std::string, std::shared_ptr<DbIndex>> indices;
+    return indices;
+}
 
+static std::shared_ptr<DbIndex>
+BuildIndex(const std::string& filename, const FileStamp& stamp)
+{
     std::ifstream file(filename);
 
     if(!file)
-    {
-        MIOPEN_LOG_W("File is unreadable: " << filename);
-        return boost::none;
-    }
+        return nullptr;
+
+    MIOPEN_LOG_I("Building index of: " << filename);
+
+    auto index   = std::make_shared<DbIndex>();
+    index->stamp = stamp;
 
-    int n_line = 0;
-    while(true)
+    std::streamoff begin = 0;
+    std::string line;
+
+    while(std::getline(file, line))
     {
-        std::string line;
-        const auto line_begin = file.tellg();
-        if(!std::getline(file, line))
-            break;
-        ++n_line;
-        const auto next_line_begin = file.tellg();
+        const auto n_line     = ++index->n_lines;
+        const auto line_begin = begin;
+        // getline() swallows the '\n', unless it was the last line without one.
+        begin += line.size() + (file.eof() ? 0 : 1);
 
         const auto key_size = line.find('=');
         const bool is_key   = (key_size != std::string::npos && key_size != 0);
@@ -172,71 +251,335 @@ boost::optional<DbRecord> Db::FindRecordUnsafe(const std::string& key, RecordPos
             {
                 MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
             }
+            ++index->dead_lines;
             continue;
         }
-        const auto current_key = line.substr(0, key_size);
 
-        if(current_key != key)
-        {
-            continue;
-        }
-        MIOPEN_LOG_I("Key match: " << current_key);
-        const auto contents = line.substr(key_size + 1);
+        auto current_key = line.substr(0, key_size);
+        auto contents    = line.substr(key_size + 1);
 
         if(contents.empty())
         {
-            MIOPEN_LOG_E("None contents under the key: " << current_key << " form file " << filename
-                                                         << "#"
-                                                         << n_line);
+            MIOPEN_LOG_I("Record removed: " << current_key << " in file " << filename << "#"
+                                            << n_line);
+            index->Remove(current_key);
             continue;
         }
-        MIOPEN_LOG_I("Contents found: " << contents);
 
-        DbRecord record(key);
-        const bool is_parse_ok = record.ParseContents(contents);
+        DbIndex::Entry entry;
+        entry.pos.begin = line_begin;
+        entry.pos.end   = begin;
+        entry.n_line    = n_line;
+        entry.contents  = std::move(contents);
 
-        if(!is_parse_ok)
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: " << current_key << " form file "
-                                                                 << filename
-                                                                 << "#"
-                                                                 << n_line);
-            MIOPEN_LOG_E("Contents: " << contents);
-        }
-        // A record with matching key have been found.
-        if(pos)
+        index->Add(std::move(current_key), std::move(entry));
+    }
+
+    return index;
+}
+
+/// Returns an up-to-date index of the file or nullptr if the file can't be read.
+/// The cached index is revalidated against the file stamp in order to notice writes made by
+/// other processes. The file is stamped before it is read, so if it is replaced in between, the
+/// index is just rebuilt once more on the next lookup. Writes made by this process either update the
+/// index (appends) or invalidate it (see InvalidateIndex).
+static std::shared_ptr<DbIndex> GetIndex(const std::string& filename)
+{
+    FileStamp stamp;
+
+    if(!GetFileStamp(filename, stamp))
+    {
+        std::lock_guard<std::mutex> lock(DbIndicesMutex());
+        DbIndices().erase(filename);
+        return nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(DbIndicesMutex());
+        const auto found = DbIndices().find(filename);
+
+        if(found != DbIndices().end() && found->second->stamp == stamp)
+            return found->second;
+    }
+
+    // Concurrent readers may build the same index twice, this is harmless.
+    auto index = BuildIndex(filename, stamp);
+
+    std::lock_guard<std::mutex> lock(DbIndicesMutex());
+    if(index)
+        DbIndices()[filename] = index;
+    else
+        DbIndices().erase(filename);
+    return index;
+}
+
+static void InvalidateIndex(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(DbIndicesMutex());
+    DbIndices().erase(filename);
+}
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PERFDB_JOURNAL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PERFDB_SNAPSHOT)
+
+static DbWriteMode GetWriteMode(DbWriteMode mode)
+{
+    if(mode != DbWriteMode::Default)
+        return mode;
+    if(miopen::IsEnabled(MIOPEN_PERFDB_SNAPSHOT{}))
+        return DbWriteMode::Snapshot;
+    if(miopen::IsEnabled(MIOPEN_PERFDB_JOURNAL{}))
+        return DbWriteMode::Journal;
+    return DbWriteMode::Rewrite;
+}
+
+Db::Db(const std::string& filename_, DbWriteMode write_mode_)
+    : filename(filename_),
+      lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
+      write_mode(GetWriteMode(write_mode_))
+{
+}
+
+boost::optional<DbRecord> Db::FindRecordUnsafe(const std::string& key, RecordPositions* pos)
+{
+    if(pos)
+    {
+        pos->begin = -1;
+        pos->end   = -1;
+    }
+
+    MIOPEN_LOG_I("Looking for key: " << key);
+
+    const auto index = GetIndex(filename);
+
+    if(!index)
+    {
+        MIOPEN_LOG_W("File is unreadable: " << filename);
+        return boost::none;
+    }
+
+    DbIndex::Entry entry;
+    {
+        // Appends of this process update the index in place.
+        std::lock_guard<std::mutex> lock(DbIndicesMutex());
+        const auto found = index->records.find(key);
+
+        if(found == index->records.end())
         {
-            pos->begin = line_begin;
-            pos->end   = next_line_begin;
+            // Record was not found
+            return boost::none;
         }
-        return record;
+
+        entry = found->second;
+    }
+
+    MIOPEN_LOG_I("Key match: " << key);
+    MIOPEN_LOG_I("Contents found: " << entry.contents);
+
+    DbRecord record(key);
+    const bool is_parse_ok = record.ParseContents(entry.contents);
+
+    if(!is_parse_ok)
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename
+                                                             << "#"
+                                                             << entry.n_line);
+        MIOPEN_LOG_E("Contents: " << entry.contents);
+    }
+    // A record with matching key have been found.
+    if(pos)
+        *pos = entry.pos;
+    return record;
+}
+
+boost::optional<DbRecord> Db::FindClosestRecord(const std::string& id,
+                                                const DbKeyDistance& distance)
+{
+    shared_lock lock;
+    if(write_mode != DbWriteMode::Snapshot)
+        lock = MakeSharedLock(lock_file);
+
+    const auto index = GetIndex(filename);
+
+    if(!index)
+    {
+        MIOPEN_LOG_W("File is unreadable: " << filename);
+        return boost::none;
+    }
+
+    auto best = std::numeric_limits<double>::infinity();
+    boost::optional<DbRecord> closest;
+
+    std::lock_guard<std::mutex> index_lock(DbIndicesMutex());
+    for(const auto& entry : index->records)
+    {
+        const auto& key = entry.first;
+        const auto d    = distance(key);
+
+        if(d > best || !(d < std::numeric_limits<double>::infinity()) ||
+           (d == best && closest && key >= closest->key))
+            continue;
+
+        DbRecord record(key);
+        if(!record.ParseContents(entry.second.contents) ||
+           record.FindValues(id) == nullptr)
+            continue;
+
+        best    = d;
+        closest = std::move(record);
     }
-    // Record was not found
-    return boost::none;
+
+    if(closest)
+        MIOPEN_LOG_I("Closest key: " << closest->key << ", distance: " << best);
+    return closest;
 }
 
 static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
 {
     constexpr auto buffer_size = 4 * 1024 * 1024;
-    char buffer[buffer_size];
+    std::vector<char> buffer(buffer_size);
     auto left = count;
 
     while(left > 0 && !from.eof())
     {
         const auto to_read = std::min<std::streamoff>(left, buffer_size);
-        from.read(buffer, to_read);
+        from.read(buffer.data(), to_read);
         const auto read = from.gcount();
-        to.write(buffer, read);
+        to.write(buffer.data(), read);
         left -= read;
     }
 }
 
+/// Flushes the file to the disk.
+static bool SyncFile(const std::string& path)
+{
+#ifdef __linux__
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+
+    if(fd < 0)
+        return false;
+
+    const auto ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+#else
+    (void)path;
+    return true;
+#endif
+}
+
+/// Replaces the file with the temp one. Readers see either the old or the new contents.
+/// If SYNC is set, the temp file is flushed to the disk before and the directory after the
+/// replacement, so that the new contents are complete even after a crash.
+static bool ReplaceFile(const std::string& temp_name, const std::string& filename, bool sync)
+{
+    boost::system::error_code ec;
+
+    if(sync && !SyncFile(temp_name))
+    {
+        MIOPEN_LOG_E("Unable to sync " << temp_name);
+        boost::filesystem::remove(temp_name, ec);
+        return false;
+    }
+
+    boost::filesystem::rename(temp_name, filename, ec);
+
+    if(ec)
+    {
+        MIOPEN_LOG_E("Unable to replace " << filename << " with " << temp_name << ": "
+                                          << ec.message());
+        boost::filesystem::remove(temp_name, ec);
+        return false;
+    }
+
+    if(sync)
+    {
+        const auto directory = boost::filesystem::path(filename).parent_path();
+        if(!SyncFile(directory.empty() ? "." : directory.string()))
+            MIOPEN_LOG_W("Unable to sync " << directory.string());
+    }
+    return true;
+}
+
+struct RecordReplacement
+{
+    RecordPositions pos;
+    const DbRecord* record; // nullptr drops the line.
+};
+
+/// Replaces the file with a copy in which lines at REPLACED positions (in ascending order) are
+/// replaced with respective records and APPENDED records are added to the end.
+/// A missing file is considered empty if there is nothing to replace.
+bool Db::RewriteUnsafe(const std::vector<RecordReplacement>& replaced,
+                       const std::vector<const DbRecord*>& appended)
+{
+    std::ifstream from(filename, std::ios::ate);
+
+    if(!from && !replaced.empty())
+    {
+        MIOPEN_LOG_E("File is unreadable: " << filename);
+        return false;
+    }
+
+    const auto temp_name = filename + ".temp";
+    std::ofstream to(temp_name);
+
+    if(!to)
+    {
+        MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+        return false;
+    }
+
+    if(from)
+    {
+        const auto from_size  = from.tellg();
+        std::streamoff copied = 0;
+        from.seekg(std::ios::beg);
+
+        for(const auto& replacement : replaced)
+        {
+            Copy(from, to, replacement.pos.begin - copied);
+            if(replacement.record != nullptr)
+                replacement.record->WriteContents(to);
+            copied = replacement.pos.end;
+            from.seekg(copied);
+        }
+
+        Copy(from, to, from_size - copied);
+        from.close();
+    }
+
+    for(const auto record : appended)
+        record->WriteContents(to);
+
+    to.close();
+
+    if(!to)
+    {
+        MIOPEN_LOG_E("Failed to write: " << temp_name);
+        boost::system::error_code ec;
+        boost::filesystem::remove(temp_name, ec);
+        return false;
+    }
+
+    return ReplaceFile(temp_name, filename, write_mode == DbWriteMode::Snapshot);
+}
+
 bool Db::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
 {
     assert(pos);
 
+    if(write_mode == DbWriteMode::Journal)
+        return AppendUnsafe(record, pos->begin >= 0);
+
+    InvalidateIndex(filename);
+
     if(pos->begin < 0 || pos->end < 0)
     {
+        // Appending in place is not atomic.
+        if(write_mode == DbWriteMode::Snapshot)
+            return RewriteUnsafe({}, {&record});
+
         std::ofstream file(filename, std::ios::app);
 
         if(!file)
@@ -247,19 +590,128 @@ bool Db::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
 
         (void)file.tellp();
         record.WriteContents(file);
+        return true;
     }
+
+    return RewriteUnsafe({{*pos, &record}}, {});
+}
+
+static std::size_t GetJournalCompactionThreshold(std::size_t live_records)
+{
+    // Keeps the amortized cost of a write constant.
+    return std::max<std::size_t>(live_records, 64);
+}
+
+bool Db::AppendUnsafe(const DbRecord& record, bool exists)
+{
+    if(record.map.empty() && !exists)
+        return true; // Nothing to remove.
+
+    std::ostringstream line;
+    if(record.map.empty())
+        line << record.key << '=' << std::endl;
     else
+        record.WriteContents(line);
+    const auto line_str = line.str();
+
+    const auto index = GetIndex(filename);
+
     {
-        std::ifstream from(filename, std::ios::ate);
+        std::ofstream file(filename, std::ios::app | std::ios::binary);
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << filename);
+            return false;
+        }
+
+        file << line_str;
+        file.close();
 
-        if(!from)
+        if(!file)
         {
-            MIOPEN_LOG_E("File is unreadable: " << filename);
+            MIOPEN_LOG_E("Failed to append to: " << filename);
+            InvalidateIndex(filename);
             return false;
         }
+    }
+
+    if(!index)
+    {
+        // The file has just been created, there is nothing to update.
+        return true;
+    }
+
+    // We own the exclusive lock, so there is noone else who could change the file and the
+    // index is updated instead of being rebuilt on the next lookup. The readers of this process
+    // share the index, so it is only changed under the mutex of the indices.
+    bool compact = false;
+    {
+        std::lock_guard<std::mutex> lock(DbIndicesMutex());
+
+        if(record.map.empty())
+        {
+            index->Remove(record.key);
+        }
+        else
+        {
+            DbIndex::Entry entry;
+            entry.pos.begin = index->stamp.size;
+            entry.pos.end   = index->stamp.size + line_str.size();
+            entry.n_line    = ++index->n_lines;
+            entry.contents  = line_str.substr(record.key.size() + 1, // Skip "KEY="
+                                             line_str.size() - record.key.size() - 2); // and '\n'
+            index->Add(record.key, std::move(entry));
+        }
+
+        if(!GetFileStamp(filename, index->stamp))
+            index->stamp = {};
+
+        compact = index->dead_lines >= GetJournalCompactionThreshold(index->records.size());
+        if(compact)
+        {
+            MIOPEN_LOG_I("Compacting journal: " << filename << ", records: "
+                                                << index->records.size()
+                                                << ", dead lines: "
+                                                << index->dead_lines);
+        }
+    }
 
-        const auto temp_name = filename + ".temp";
-        std::ofstream to(temp_name);
+    return compact ? CompactUnsafe() : true;
+}
+
+bool Db::Compact()
+{
+    const auto lock = MakeExclusiveLock(lock_file);
+    return CompactUnsafe();
+}
+
+bool Db::CompactUnsafe()
+{
+    const auto index = GetIndex(filename);
+
+    if(!index)
+    {
+        MIOPEN_LOG_W("File is unreadable: " << filename);
+        return false;
+    }
+
+    if(index->dead_lines == 0)
+        return true;
+
+    // Keep the records in order of appearance.
+    std::vector<std::pair<const std::string*, const DbIndex::Entry*>> records;
+    records.reserve(index->records.size());
+    for(const auto& record : index->records)
+        records.emplace_back(&record.first, &record.second);
+    std::sort(records.begin(), records.end(), [](const auto& left, const auto& right) {
+        return left.second->pos.begin < right.second->pos.begin;
+    });
+
+    const auto temp_name = filename + ".temp";
+
+    {
+        std::ofstream to(temp_name, std::ios::binary | std::ios::trunc);
 
         if(!to)
         {
@@ -267,22 +719,20 @@ bool Db::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
             return false;
         }
 
-        const auto from_size = from.tellg();
-        from.seekg(std::ios::beg);
-
-        Copy(from, to, pos->begin);
-        record.WriteContents(to);
-        from.seekg(pos->end);
-        Copy(from, to, from_size - pos->end);
+        for(const auto& record : records)
+            to << *record.first << '=' << record.second->contents << '\n';
 
-        from.close();
         to.close();
 
-        std::remove(filename.c_str());
-        std::rename(temp_name.c_str(), filename.c_str());
-        /// \todo What if rename fails? Thou shalt not loose the original file.
+        if(!to)
+        {
+            MIOPEN_LOG_E("Failed to write: " << temp_name);
+            return false;
+        }
     }
-    return true;
+
+    InvalidateIndex(filename);
+    return ReplaceFile(temp_name, filename, write_mode == DbWriteMode::Snapshot);
 }
 
 bool Db::StoreRecordUnsafe(const DbRecord& record)
@@ -324,4 +774,123 @@ bool Db::RemoveRecordUnsafe(const std::string& key)
     return FlushUnsafe(empty_record, &pos);
 }
 
+bool Db::Transaction::Commit()
+{
+    if(changes.empty())
+        return true;
+
+    const auto lock   = MakeExclusiveLock(db.lock_file);
+    const auto result = db.CommitUnsafe(changes);
+    changes.clear();
+    return result;
+}
+
+bool Db::CommitUnsafe(const std::vector<Transaction::Change>& changes)
+{
+    struct Result
+    {
+        RecordPositions pos;
+        boost::optional<DbRecord> record;
+    };
+
+    MIOPEN_LOG_I("Committing " << changes.size() << " changes to " << filename);
+
+    // Keys in order of their first change, new records are appended in this order.
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, Result> results;
+
+    for(const auto& change : changes)
+    {
+        const auto& key = change.record.key;
+        auto found      = results.find(key);
+
+        if(found == results.end())
+        {
+            Result result;
+            result.record = FindRecordUnsafe(key, &result.pos);
+            found         = results.emplace(key, std::move(result)).first;
+            keys.push_back(key);
+        }
+
+        auto& record = found->second.record;
+
+        switch(change.kind)
+        {
+        case Transaction::Kind::Store: record = change.record; break;
+        case Transaction::Kind::Update:
+            if(record)
+            {
+                DbRecord new_record(change.record);
+                new_record.Merge(*record);
+                record = std::move(new_record);
+            }
+            else
+            {
+                record = change.record;
+            }
+            break;
+        case Transaction::Kind::RemoveRecord: record = boost::none; break;
+        case Transaction::Kind::Remove:
+            if(record)
+                record->EraseValues(change.id);
+            break;
+        }
+
+        if(record && record->map.empty())
+            record = boost::none;
+    }
+
+    if(write_mode == DbWriteMode::Journal)
+    {
+        auto ok = true;
+        for(const auto& key : keys)
+        {
+            const auto& result = results.at(key);
+            const auto exists  = result.pos.begin >= 0;
+            ok = AppendUnsafe(result.record ? *result.record : DbRecord(key), exists) && ok;
+        }
+        return ok;
+    }
+
+    InvalidateIndex(filename);
+
+    std::vector<RecordReplacement> replaced;
+    std::vector<const DbRecord*> appended;
+
+    for(const auto& key : keys)
+    {
+        const auto& result = results.at(key);
+        const auto record  = result.record ? &*result.record : nullptr;
+
+        if(result.pos.begin >= 0 && result.pos.end >= 0)
+            replaced.push_back({result.pos, record});
+        else if(record != nullptr)
+            appended.push_back(record);
+    }
+
+    if(replaced.empty() && write_mode != DbWriteMode::Snapshot)
+    {
+        if(appended.empty())
+            return true;
+
+        std::ofstream file(filename, std::ios::app);
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << filename);
+            return false;
+        }
+
+        for(const auto record : appended)
+            record->WriteContents(file);
+        return true;
+    }
+
+    std::sort(replaced.begin(), replaced.end(), [](const auto& left, const auto& right) {
+        return left.pos.begin < right.pos.begin;
+    });
+
+    return RewriteUnsafe(replaced, appended);
+}
+
 } // namespace miopen
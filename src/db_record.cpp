@@ -23,11 +23,9 @@
  * SOFTWARE.
  *
  *******************************************************************************/
-#include <iostream>
-#include <numeric>
+#include <algorithm>
 #include <ostream>
 #include <string>
-#include <unordered_map>
 #include <utility>
 
 #include <miopen/db_record.hpp>
@@ -35,10 +33,28 @@
 
 namespace miopen {
 
+namespace {
+
+template <class Contents>
+auto FindId(Contents& map, const std::string& id) -> decltype(map.begin())
+{
+    return std::find_if(map.begin(), map.end(), [&](const typename Contents::value_type& pair) {
+        return pair.first == id;
+    });
+}
+
+} // namespace
+
+const std::string* DbRecord::FindValues(const std::string& id) const
+{
+    const auto it = FindId(map, id);
+    return it == map.end() ? nullptr : &it->second;
+}
+
 bool DbRecord::SetValues(const std::string& id, const std::string& values)
 {
     // No need to update the file if values are the same:
-    const auto it = map.find(id);
+    const auto it = FindId(map, id);
     if(it == map.end() || it->second != values)
     {
         MIOPEN_LOG_I("Record under key: " << key << ", content "
@@ -47,7 +63,10 @@ bool DbRecord::SetValues(const std::string& id, const std::string& values)
                                           << id
                                           << ':'
                                           << values);
-        map[id] = values;
+        if(it == map.end())
+            map.emplace_back(id, values);
+        else
+            it->second = values;
         return true;
     }
     MIOPEN_LOG_I("Record under key: " << key << ", content is the same, not changed:" << id << ':'
@@ -55,21 +74,9 @@ bool DbRecord::SetValues(const std::string& id, const std::string& values)
     return false;
 }
 
-bool DbRecord::GetValues(const std::string& id, std::string& values) const
-{
-    const auto it = map.find(id);
-
-    if(it == map.end())
-        return false;
-
-    values = it->second;
-    MIOPEN_LOG_I("Read record " << key << '=' << id << ':' << values);
-    return true;
-}
-
 bool DbRecord::EraseValues(const std::string& id)
 {
-    const auto it = map.find(id);
+    const auto it = FindId(map, id);
     if(it != map.end())
     {
         MIOPEN_LOG_I("Record under key: " << key << ", removed: " << id << ':' << it->second);
@@ -82,34 +89,38 @@ bool DbRecord::EraseValues(const std::string& id)
 
 bool DbRecord::ParseContents(const std::string& contents)
 {
-    std::istringstream ss(contents);
-    std::string id_and_values;
-    int found = 0;
+    auto first      = contents.data();
+    const auto last = contents.data() + contents.size();
+    int found       = 0;
 
     map.clear();
 
-    while(std::getline(ss, id_and_values, ';'))
+    while(first != last)
     {
-        const auto id_size = id_and_values.find(':');
+        const auto end    = std::find(first, last, ';');
+        const auto id_end = std::find(first, end, ':');
 
         // Empty VALUES is ok, empty ID is not:
-        if(id_size == std::string::npos)
+        if(id_end == end)
         {
             MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << key);
-            continue;
         }
-
-        const auto id     = id_and_values.substr(0, id_size);
-        const auto values = id_and_values.substr(id_size + 1);
-
-        if(map.find(id) != map.end())
+        else
         {
-            MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
-            continue;
+            std::string id(first, id_end);
+
+            if(FindValues(id) != nullptr)
+            {
+                MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
+            }
+            else
+            {
+                map.emplace_back(std::move(id), std::string(id_end + 1, end));
+                ++found;
+            }
         }
 
-        map.emplace(id, values);
-        ++found;
+        first = end == last ? last : end + 1;
     }
 
     return (found > 0);
@@ -122,13 +133,16 @@ void DbRecord::WriteContents(std::ostream& stream) const
 
     stream << key << '=';
 
-    const auto pairsJoiner = [](const std::string& sum,
-                                const std::pair<std::string, std::string>& pair) {
-        const auto pair_str = pair.first + ':' + pair.second;
-        return sum.empty() ? pair_str : sum + ';' + pair_str;
-    };
+    auto sep = false;
+    for(const auto& pair : map)
+    {
+        if(sep)
+            stream << ';';
+        stream << pair.first << ':' << pair.second;
+        sep = true;
+    }
 
-    stream << std::accumulate(map.begin(), map.end(), std::string(), pairsJoiner) << std::endl;
+    stream << std::endl;
 }
 
 void DbRecord::Merge(const DbRecord& that)
@@ -138,9 +152,9 @@ void DbRecord::Merge(const DbRecord& that)
 
     for(const auto& that_pair : that.map)
     {
-        if(map.find(that_pair.first) != map.end())
+        if(FindValues(that_pair.first) != nullptr)
             continue;
-        map[that_pair.first] = that_pair.second;
+        map.push_back(that_pair);
     }
 }
 } // namespace miopen
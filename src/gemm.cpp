@@ -329,7 +329,7 @@ GemmGeometry CreateMIOpenGemmGeometry(int M,
 
 GemmGeometry GetGemmGeometry(Handle& handle, std::string algorithm_name, std::string network_config)
 {
-    auto gemm_iterator = handle.geo_map.find(std::make_pair(algorithm_name, network_config));
+    auto gemm_iterator = handle.geo_map.find(KernelKey{algorithm_name, network_config});
     if(gemm_iterator != handle.geo_map.end())
     {
         return *gemm_iterator->second;
@@ -390,7 +390,7 @@ GemmGeometry ScanGemmGeometryRNN(Handle& handle,
     auto gg = CreateGemmGeometryRNN(
         M, N, K, alpha, beta, tA, tB, tC, lda, ldb, ldc, isDataColMajor, network_config);
 
-    auto gemm_iterator = handle.geo_map.find(std::make_pair("miopenRNNAlgoGEMM", network_config));
+    auto gemm_iterator = handle.geo_map.find(KernelKey{"miopenRNNAlgoGEMM", network_config});
     if(gemm_iterator != handle.geo_map.end())
     {
         gg = *gemm_iterator->second;
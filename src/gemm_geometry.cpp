@@ -129,7 +129,7 @@ void GemmGeometry::FindSolution(
             vgd,
             "");
     }
-    handle.geo_map[std::make_pair(algorithm_name, network_config)] =
+    handle.geo_map[KernelKey{algorithm_name, network_config}] =
         std::make_unique<GemmGeometry>(*this);
 }
 
@@ -23,9 +23,14 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <miopen/binary_cache.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/kernel_trace.hpp>
 
 extern "C" miopenStatus_t miopenCreate(miopenHandle_t* handle)
 {
@@ -72,3 +77,107 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenSetMemoryPoolCapacity(miopenHandle_t handle, size_t capacity)
+{
+    return miopen::try_([&] { miopen::deref(handle).SetMemoryPoolCapacity(capacity); });
+}
+
+extern "C" miopenStatus_t miopenTrimMemoryPool(miopenHandle_t handle)
+{
+    return miopen::try_([&] { miopen::deref(handle).TrimMemoryPool(); });
+}
+
+extern "C" miopenStatus_t miopenGetMemoryPoolStats(miopenHandle_t handle,
+                                                   miopenMemoryPoolStats_t* stats)
+{
+    return miopen::try_([&] {
+        const auto pool_stats = miopen::deref(handle).GetMemoryPoolStats();
+        auto& result          = miopen::deref(stats);
+        result.inUseSize      = pool_stats.in_use;
+        result.cachedSize     = pool_stats.cached;
+        result.peakSize       = pool_stats.peak;
+        result.hitCount       = pool_stats.hits;
+        result.missCount      = pool_stats.misses;
+    });
+}
+
+extern "C" miopenStatus_t miopenEnableWorkspaceArena(miopenHandle_t handle, size_t sizeLimit)
+{
+    return miopen::try_([&] { miopen::deref(handle).EnableWorkspaceArena(sizeLimit); });
+}
+
+extern "C" miopenStatus_t miopenEnableKernelTrace(miopenHandle_t handle, size_t capacity)
+{
+    return miopen::try_([&] { miopen::deref(handle).EnableKernelTrace(capacity); });
+}
+
+static void CopyTruncated(const std::string& str, char* dst, std::size_t size)
+{
+    const auto length = std::min(str.size(), size - 1);
+    std::memcpy(dst, str.data(), length);
+    dst[length] = '\0';
+}
+
+extern "C" miopenStatus_t
+miopenGetKernelTrace(miopenHandle_t handle, miopenKernelTraceEntry_t* entries, size_t* count)
+{
+    return miopen::try_([&] {
+        auto& n             = miopen::deref(count);
+        const auto launches = miopen::deref(handle).GetKernelTrace();
+        if(entries == nullptr)
+        {
+            n = launches.size();
+            return;
+        }
+
+        // The newest launches if the array is too small.
+        const auto first = launches.size() - std::min(n, launches.size());
+        n                = launches.size() - first;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const auto& launch = launches[first + i];
+            auto& entry        = entries[i];
+            CopyTruncated(launch.kernel_name, entry.kernelName, sizeof(entry.kernelName));
+            CopyTruncated(launch.network_config, entry.networkConfig, sizeof(entry.networkConfig));
+            entry.queuedTime = launch.queued;
+            entry.startTime  = launch.start;
+            entry.endTime    = launch.end;
+        }
+    });
+}
+
+extern "C" miopenStatus_t miopenDumpKernelTrace(miopenHandle_t handle, const char* fileName)
+{
+    return miopen::try_([&] {
+        if(fileName == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "No file name");
+        std::ofstream file(fileName);
+        if(!file)
+            MIOPEN_THROW(miopenStatusBadParm, "Cannot open " + std::string(fileName));
+        miopen::WriteChromeTrace(file, miopen::deref(handle).GetKernelTrace());
+    });
+}
+
+extern "C" miopenStatus_t
+miopenWaitForPrecompiled(miopenHandle_t handle, size_t* builtCount, size_t* failedCount)
+{
+    return miopen::try_([&] {
+        miopen::deref(builtCount) = miopen::deref(handle).WaitForPrecompiled(
+            miopen::deref(failedCount));
+    });
+}
+
+extern "C" miopenStatus_t miopenGetBinaryCacheStats(miopenBinaryCacheStats_t* stats)
+{
+    return miopen::try_([&] {
+        const auto cache_stats    = miopen::GetBinaryCacheStats();
+        auto& result              = miopen::deref(stats);
+        result.hitCount           = cache_stats.hits;
+        result.missCount          = cache_stats.misses;
+        result.bytesRead          = cache_stats.bytes_read;
+        result.compileTimeAvoided = cache_stats.compile_time_avoided;
+        result.evictionCount      = cache_stats.evictions;
+        result.bytesEvicted       = cache_stats.bytes_evicted;
+    });
+}
@@ -105,6 +105,15 @@ void set_ctx(hipCtx_t ctx)
         MIOPEN_THROW("Error setting context");
 }
 
+void set_ctx(hipCtx_t ctx, int device)
+{
+    set_ctx(ctx);
+    // set_device(device);
+    // Check device matches
+    if(device != get_device_id())
+        MIOPEN_THROW("Running handle on wrong device");
+}
+
 int set_default_device()
 {
     int n;
@@ -148,20 +157,16 @@ struct HandleImpl
             &HandleImpl::elapsed_time, this, std::placeholders::_1, std::placeholders::_2);
     }
 
-    void set_ctx()
-    {
-        miopen::set_ctx(this->ctx);
-        // miopen::set_device(this->device);
-        // Check device matches
-        if(this->device != get_device_id())
-            MIOPEN_THROW("Running handle on wrong device");
-    }
+    void set_ctx() { miopen::set_ctx(this->ctx, this->device); }
 
     bool enable_profiling  = false;
+    bool precompile_only   = false;
     StreamPtr stream       = nullptr;
     float profiling_result = 0.0;
     int device             = -1;
     Allocator allocator{};
+    MemoryPool pool;
+    std::shared_ptr<WorkspaceArena> workspace_arena;
     KernelCache cache;
     hipCtx_t ctx;
 };
@@ -176,6 +181,8 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
     else
         this->impl->stream = HandleImpl::reference_stream(stream);
 
+    // The context identifies the device.
+    this->impl->cache.SharePrograms(this->impl->ctx, nullptr);
     this->SetAllocator(nullptr, nullptr, nullptr);
 }
 
@@ -190,6 +197,7 @@ Handle::Handle() : impl(new HandleImpl())
     this->impl->ctx    = get_ctx();
     this->impl->stream = HandleImpl::reference_stream(nullptr);
 #endif
+    this->impl->cache.SharePrograms(this->impl->ctx, nullptr);
     this->SetAllocator(nullptr, nullptr, nullptr);
 }
 
@@ -210,6 +218,48 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
     this->impl->allocator.context = allocatorContext;
+
+    this->impl->pool.SetAllocator(this->impl->allocator);
+    if(allocator != nullptr)
+    {
+        this->impl->pool.SetCapacity(0);
+        return;
+    }
+
+    hipDeviceProp_t props{};
+    auto status = hipGetDeviceProperties(&props, this->impl->device);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status);
+    this->impl->pool.SetCapacity(MemoryPool::GetDefaultCapacity(props.totalGlobalMem));
+}
+
+void Handle::SetMemoryPoolCapacity(std::size_t capacity) const
+{
+    this->impl->pool.SetCapacity(capacity);
+}
+
+void Handle::TrimMemoryPool() const { this->impl->pool.Trim(); }
+
+MemoryPoolStats Handle::GetMemoryPoolStats() const { return this->impl->pool.GetStats(); }
+
+void Handle::EnableWorkspaceArena(std::size_t limit)
+{
+    if(limit == this->GetWorkspaceArenaLimit())
+        return;
+    // The workspaces in use keep the previous arena.
+    this->impl->workspace_arena = limit == 0 ? nullptr : std::make_shared<WorkspaceArena>(limit);
+}
+
+std::size_t Handle::GetWorkspaceArenaLimit() const
+{
+    return this->impl->workspace_arena == nullptr ? 0 : this->impl->workspace_arena->GetLimit();
+}
+
+Workspace Handle::GetWorkspace(std::size_t sz)
+{
+    if(this->impl->workspace_arena == nullptr)
+        MIOPEN_THROW("The workspace arena is disabled");
+    return this->impl->workspace_arena->Get(*this, sz);
 }
 
 void Handle::EnableProfiling(bool enable) { this->impl->enable_profiling = enable; }
@@ -220,7 +270,7 @@ Allocator::ManageDataPtr Handle::Create(std::size_t sz)
 {
     MIOPEN_HANDLE_LOCK
     this->Finish();
-    return this->impl->allocator(sz);
+    return this->impl->pool(sz);
 }
 Allocator::ManageDataPtr&
 Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz)
@@ -241,6 +291,43 @@ void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size
         MIOPEN_THROW_HIP_STATUS(status, "Hip error reading from buffer: ");
 }
 
+static Handle::Transfer RecordTransfer(hipStream_t stream, const std::string& message)
+{
+    hipEvent_t e;
+    auto status = hipEventCreate(&e);
+    if(status == hipSuccess)
+        status = hipEventRecord(e, stream);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error " + message);
+    std::shared_ptr<typename std::remove_pointer<hipEvent_t>::type> event{e, &hipEventDestroy};
+    return std::async(std::launch::deferred,
+                      [ event = std::move(event), message ] {
+                          auto s = hipEventSynchronize(event.get());
+                          if(s != hipSuccess)
+                              MIOPEN_THROW_HIP_STATUS(s, "Hip error " + message);
+                      })
+        .share();
+}
+
+// The copies are made on the stream of the handle, without staging them through pinned memory.
+Handle::Transfer Handle::WriteToAsync(const void* data, Data_t ddata, std::size_t sz)
+{
+    MIOPEN_HANDLE_LOCK
+    auto status = hipMemcpyAsync(ddata, data, sz, hipMemcpyHostToDevice, this->GetStream());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error writing to buffer: ");
+    return RecordTransfer(this->GetStream(), "writing to buffer: ");
+}
+
+Handle::Transfer Handle::ReadToAsync(void* data, ConstData_t ddata, std::size_t sz)
+{
+    MIOPEN_HANDLE_LOCK
+    auto status = hipMemcpyAsync(data, ddata, sz, hipMemcpyDeviceToHost, this->GetStream());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error reading from buffer: ");
+    return RecordTransfer(this->GetStream(), "reading from buffer: ");
+}
+
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size)
 {
     MIOPEN_HANDLE_LOCK
@@ -250,8 +337,52 @@ void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size)
         MIOPEN_THROW_HIP_STATUS(status, "Hip error copying buffer: ");
 }
 
-KernelInvoke Handle::AddKernel(const std::string& algorithm,
-                               const std::string& network_config,
+static Program LoadCachedProgram(hipCtx_t ctx,
+                                 int device,
+                                 const std::string& device_name,
+                                 const std::string& program_name,
+                                 std::string params,
+                                 bool is_kernel_str)
+{
+    set_ctx(ctx, device);
+    params += " -mcpu=" + device_name;
+    auto cache_binary = miopen::LoadBinary(device_name, program_name, params, is_kernel_str);
+    if(cache_binary.empty())
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        auto p = HIPOCProgram{program_name, params, is_kernel_str};
+
+        const auto compile_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      std::chrono::steady_clock::now() - start)
+                                      .count();
+
+        // Save to cache
+        auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
+        boost::filesystem::copy_file(p.GetBinary(), path);
+        miopen::SaveBinary(path, device_name, program_name, params, is_kernel_str, compile_time);
+
+        return p;
+    }
+    else
+    {
+        return HIPOCProgram{program_name, cache_binary};
+    }
+}
+
+// The context, device and device name are resolved in the calling thread, so that the loader does
+// not use the handle from the background thread.
+static KernelCache::ProgramLoader GetProgramLoader(Handle& h, const HandleImpl& impl)
+{
+    const auto ctx         = impl.ctx;
+    const auto device      = impl.device;
+    const auto device_name = h.GetDeviceName();
+    return [=](const std::string& program_name, const std::string& params, bool is_kernel_str) {
+        return LoadCachedProgram(ctx, device, device_name, program_name, params, is_kernel_str);
+    };
+}
+
+KernelInvoke Handle::AddKernel(const KernelKey& key,
                                const std::string& program_name,
                                const std::string& kernel_name,
                                const std::vector<size_t>& vld,
@@ -259,16 +390,42 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                const std::string& params,
                                std::size_t cache_index)
 {
+    if(this->impl->precompile_only)
+    {
+        const bool is_kernel_str = key.GetAlgorithm().GetName().find("GEMM") != std::string::npos;
+        this->impl->cache.Precompile(
+            GetProgramLoader(*this, *this->impl), program_name, params, is_kernel_str);
+        return {};
+    }
 
     auto obj = this->impl->cache.AddKernel(
-        *this, algorithm, network_config, program_name, kernel_name, vld, vgd, params, cache_index);
+        *this, key, program_name, kernel_name, vld, vgd, params, cache_index);
     return this->Run(obj);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config)
+void Handle::PrecompileProgram(const std::string& program_name,
+                               const std::string& params,
+                               bool is_kernel_str)
+{
+    this->impl->cache.Precompile(
+        GetProgramLoader(*this, *this->impl), program_name, params, is_kernel_str);
+}
+
+std::size_t Handle::WaitForPrecompiled(std::size_t& failed)
 {
-    return this->impl->cache.GetKernels(algorithm, network_config);
+    const auto result = this->impl->cache.WaitForPrecompiled();
+    failed            = result.failed;
+    return result.built;
+}
+
+const std::vector<Kernel>& Handle::GetKernelsImpl(const KernelKey& key)
+{
+    if(this->impl->precompile_only)
+    {
+        static const std::vector<Kernel> none;
+        return none;
+    }
+    return this->impl->cache.GetKernels(key);
 }
 
 KernelInvoke Handle::Run(Kernel k)
@@ -280,27 +437,32 @@ KernelInvoke Handle::Run(Kernel k)
         return k.Invoke(this->GetStream());
 }
 
-Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
+KernelInvoke Handle::Run(Kernel k, const KernelKey&) { return this->Run(std::move(k)); }
+
+void Handle::EnableKernelTrace(std::size_t capacity)
 {
-    this->impl->set_ctx();
-    params += " -mcpu=" + this->GetDeviceName();
-    auto cache_file =
-        miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
-    if(cache_file.empty())
-    {
-        auto p = HIPOCProgram{program_name, params, is_kernel_str};
+    if(capacity != 0)
+        MIOPEN_THROW(miopenStatusNotImplemented, "The kernel trace is not supported with HIP");
+}
 
-        // Save to cache
-        auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
-        boost::filesystem::copy_file(p.GetBinary(), path);
-        miopen::SaveBinary(path, this->GetDeviceName(), program_name, params, is_kernel_str);
+std::vector<KernelTraceEntry> Handle::GetKernelTrace() { return {}; }
 
-        return p;
-    }
-    else
-    {
-        return HIPOCProgram{program_name, cache_file};
-    }
+void Handle::BeginRecording() {}
+
+void Handle::EndRecording(const KernelKey&, const std::vector<ConstData_t>&) {}
+
+void Handle::CancelRecording() {}
+
+bool Handle::Replay(const KernelKey&, const std::vector<ConstData_t>&) { return false; }
+
+Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
+{
+    return LoadCachedProgram(this->impl->ctx,
+                             this->impl->device,
+                             this->GetDeviceName(),
+                             program_name,
+                             params,
+                             is_kernel_str);
 }
 
 void Handle::Finish() const
@@ -332,6 +494,10 @@ void Handle::Flush() const {}
 
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
+void Handle::EnablePrecompileOnly(bool enable) { this->impl->precompile_only = enable; }
+
+bool Handle::IsPrecompileOnlyEnabled() const { return this->impl->precompile_only; }
+
 void Handle::ResetKernelTime() { this->impl->profiling_result = 0.0; }
 void Handle::AccumKernelTime(float curr_time) { this->impl->profiling_result += curr_time; }
 
@@ -90,9 +90,13 @@ hipModulePtr CreateModule(const boost::filesystem::path& hsaco_file)
 
 struct HIPOCProgramImpl
 {
-    HIPOCProgramImpl(const std::string& program_name, const boost::filesystem::path& hsaco)
-        : name(program_name), hsaco_file(hsaco)
+    HIPOCProgramImpl(const std::string& program_name, const std::string& hsaco)
+        : name(program_name)
     {
+        // The name can be the source of a kernel, so it is not used for the file.
+        dir.emplace("hsaco");
+        hsaco_file = dir->path / "binary.o";
+        WriteFile(hsaco, hsaco_file);
         this->module = CreateModule(this->hsaco_file);
     }
     HIPOCProgramImpl(const std::string& program_name, std::string params, bool is_kernel_str)
@@ -143,7 +147,7 @@ HIPOCProgram::HIPOCProgram(const std::string& program_name, std::string params,
 {
 }
 
-HIPOCProgram::HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco)
+HIPOCProgram::HIPOCProgram(const std::string& program_name, const std::string& hsaco)
     : impl(std::make_shared<HIPOCProgramImpl>(program_name, hsaco))
 {
 }
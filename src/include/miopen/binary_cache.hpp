@@ -27,26 +27,120 @@
 #ifndef GUARD_MLOPEN_BINARY_CACHE_HPP
 #define GUARD_MLOPEN_BINARY_CACHE_HPP
 
-#include <string>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace miopen {
 
+/// Counters of a binary cache since the start of the process.
+struct BinaryCacheStats
+{
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
+    /// Sizes of the binaries loaded.
+    std::uint64_t bytes_read = 0;
+    /// Sum of the compilation times of the binaries loaded, in ms.
+    std::uint64_t compile_time_avoided = 0;
+    /// Binaries removed to keep the cache within its size limit.
+    std::size_t evictions = 0;
+    std::uint64_t bytes_evicted = 0;
+};
+
+/// Program binaries packed into a single append-only data file with an index of fixed size
+/// entries (md5 of the key, offset and size of the binary, time of the last use and the time
+/// the compilation took) in a sibling file. The index is read once and then only its new
+/// entries are, and the data file is mapped to memory.
+///
+/// Binaries are appended under the lock file of the data file, data first and then the index
+/// entry, so readers never lock: an entry is visible only when its data is complete, and a
+/// partially written last entry is ignored. The last entry for a key wins.
+///
+/// Once the data file exceeds the size limit, it is compacted under the same lock to 3/4 of
+/// the limit, least recently used binaries are evicted. New data and index files are renamed
+/// over the old ones; each binary is preceded by its key in the data file, so readers detect
+/// the replacement and read the index again.
+///
+/// All operations are MP- and MT-safe.
+class BinaryArchive
+{
+    public:
+    /// Zero size_limit means no limit.
+    BinaryArchive(const boost::filesystem::path& directory, std::uint64_t size_limit_ = 0);
+    BinaryArchive(const BinaryArchive&) = delete;
+    BinaryArchive& operator=(const BinaryArchive&) = delete;
+
+    /// Returns none if there is no binary under the key.
+    boost::optional<std::string> Load(const std::string& key);
+    /// Returns false if the binary could not be written.
+    bool Save(const std::string& key, const std::string& binary, std::uint64_t compile_time = 0);
+
+    BinaryCacheStats GetStats();
+
+    const boost::filesystem::path& DataPath() const { return data_path; }
+    const boost::filesystem::path& IndexPath() const { return index_path; }
+
+    private:
+    struct Location
+    {
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::uint64_t last_used;
+        std::uint64_t compile_time;
+        std::uint64_t position; // of the entry in the index file
+    };
+
+    boost::filesystem::path data_path;
+    boost::filesystem::path index_path;
+    /// Serializes the writers of all the processes. Unlike the data and the index, it is never
+    /// replaced by a compaction, so all of them always lock the same file.
+    boost::filesystem::path lock_path;
+    std::uint64_t size_limit;
+    std::mutex mutex;
+    std::unordered_map<std::string, Location> index;
+    std::uint64_t index_read = 0;
+    boost::interprocess::file_mapping data_file;
+    boost::interprocess::mapped_region data;
+    BinaryCacheStats stats;
+
+    void ReadIndexUnsafe();
+    void ResetUnsafe();
+    bool MapDataUnsafe(std::uint64_t size);
+    boost::optional<std::string> ReadBinaryUnsafe(const std::string& key_hash, bool& stale);
+    void TouchUnsafe(const std::string& key_hash, Location& location);
+    /// Shall be called under the lock file, as Save() does.
+    void CompactUnsafe(std::uint64_t target_size);
+};
+
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
                                      bool is_kernel_str);
 
 boost::filesystem::path GetCachePath();
+
+/// Returns the binary of the program or an empty string if it is not in the cache.
 std::string LoadBinary(const std::string& device,
                        const std::string& name,
                        const std::string& args,
                        bool is_kernel_str = false);
+/// Moves the binary into the cache. The file is removed.
+/// compile_time is the time the compilation took in ms, see BinaryCacheStats.
 void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& device,
                 const std::string& name,
                 const std::string& args,
-                bool is_kernel_str = false);
+                bool is_kernel_str         = false,
+                std::uint64_t compile_time = 0);
+
+/// Counters of the binary cache of the process. A summary is logged at exit.
+BinaryCacheStats GetBinaryCacheStats();
 
 } // namespace miopen
 
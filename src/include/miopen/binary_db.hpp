@@ -0,0 +1,86 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_BINARY_DB_HPP_
+#define GUARD_MIOPEN_BINARY_DB_HPP_
+
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <memory>
+#include <string>
+
+namespace miopen {
+
+struct BinaryDbFile;
+
+/// Read-only perf db in the binary format (see binary_db_format.hpp).
+/// The file is memory-mapped once per process and shared between all instances, so
+/// lookups are a binary search over the mapped memory: there is neither file I/O nor parsing
+/// of the whole file and no locking is required.
+///
+/// A missing or corrupted file behaves as an empty db.
+class BinaryDb
+{
+    public:
+    BinaryDb(const std::string& filename_);
+
+    /// Returns false if the file is missing, empty or corrupted.
+    bool IsAvailable() const { return file != nullptr; }
+
+    /// Searches db for provided key and returns found record or none if key not found in database
+    boost::optional<DbRecord> FindRecord(const std::string& key) const;
+
+    template <class T>
+    inline boost::optional<DbRecord> FindRecord(const T& problem_config) const
+    {
+        const auto key = DbRecord::Serialize(problem_config);
+        return FindRecord(key);
+    }
+
+    /// See Db::FindClosestRecord().
+    boost::optional<DbRecord> FindClosestRecord(const std::string& id,
+                                                const DbKeyDistance& distance) const;
+
+    /// Searches for record with key PROBLEM_CONFIG and gets VALUES under the ID from it.
+    /// See Db::Load() for requirements to T and V.
+    template <class T, class V>
+    inline bool Load(const T& problem_config, const std::string& id, V& values) const
+    {
+        const auto record = FindRecord(problem_config);
+
+        if(!record)
+            return false;
+        return record->GetValues(id, values);
+    }
+
+    private:
+    std::string filename;
+    std::shared_ptr<const BinaryDbFile> file;
+};
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BINARY_DB_HPP_
@@ -0,0 +1,184 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_BINARY_DB_FORMAT_HPP_
+#define GUARD_MIOPEN_BINARY_DB_FORMAT_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace binary_db {
+
+/// Binary db is a read-only, compact form of a text perf db (see db_record.hpp),
+/// intended to be memory-mapped and searched in place.
+///
+/// Layout:
+///   Header
+///   Entry[record_count], sorted by KEY (byte-wise)
+///   String pool: KEY and contents ("ID:VALUES;..." as in the text db) of each record,
+///   back to back, not null-terminated.
+///
+/// Offsets in entries are relative to the beginning of the pool.
+/// Files use the native byte order, as these are produced at build time for the target.
+
+constexpr std::uint32_t FormatVersion = 1;
+
+inline const char* Magic() { return "MIOpenDB"; }
+constexpr std::size_t MagicSize = 8;
+
+struct Header
+{
+    char magic[MagicSize];
+    std::uint32_t version;
+    std::uint32_t record_count;
+    std::uint64_t entries_offset;
+    std::uint64_t pool_offset;
+    std::uint64_t pool_size;
+};
+
+struct Entry
+{
+    std::uint32_t key_offset; // Contents follow the key.
+    std::uint32_t key_size;
+    std::uint32_t contents_size;
+};
+
+using TextRecords = std::vector<std::pair<std::string, std::string>>;
+
+/// Counts lines of a text db read by ReadTextDb().
+struct TextDbStats
+{
+    std::size_t lines      = 0;
+    std::size_t ill_formed = 0;
+    std::size_t removals   = 0; // "KEY=" lines.
+    std::size_t overridden = 0; // Lines replaced or removed by a later line with the same KEY.
+};
+
+/// Reads KEY=CONTENTS lines of a text db and returns the records sorted by KEY.
+/// Follows the rules of the text db lookup: ill-formed lines are skipped, the last line with
+/// a KEY wins and a line with empty contents removes the KEY.
+/// Messages about ill-formed lines are written to the log.
+inline TextRecords ReadTextDb(std::istream& text,
+                              std::ostream& log,
+                              const std::string& name,
+                              TextDbStats* stats = nullptr)
+{
+    TextDbStats dummy_stats;
+    if(stats == nullptr)
+        stats = &dummy_stats;
+
+    std::map<std::string, std::string> records;
+    std::string line;
+    int n_line = 0;
+
+    while(std::getline(text, line))
+    {
+        ++n_line;
+        ++stats->lines;
+        const auto key_size = line.find('=');
+
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            if(!line.empty())
+            {
+                log << "Ill-formed record: key not found: " << name << "#" << n_line << std::endl;
+                ++stats->ill_formed;
+            }
+            continue;
+        }
+
+        auto key = line.substr(0, key_size);
+
+        if(key_size + 1 == line.size())
+        {
+            ++stats->removals;
+            stats->overridden += records.erase(key);
+        }
+        else
+        {
+            auto& contents = records[std::move(key)];
+            if(!contents.empty())
+                ++stats->overridden;
+            contents = line.substr(key_size + 1);
+        }
+    }
+
+    return {records.begin(), records.end()};
+}
+
+/// Writes records, which shall be sorted by KEY and have no duplicates, in the binary db format.
+/// Returns false if records do not fit into the format.
+inline bool WriteBinaryDb(const TextRecords& records, std::ostream& binary)
+{
+    Header header{};
+    std::copy(Magic(), Magic() + MagicSize, header.magic);
+    header.version        = FormatVersion;
+    header.record_count   = static_cast<std::uint32_t>(records.size());
+    header.entries_offset = sizeof(Header);
+    header.pool_offset    = header.entries_offset + sizeof(Entry) * records.size();
+
+    std::vector<Entry> entries;
+    entries.reserve(records.size());
+    std::uint64_t pool_size = 0;
+
+    for(const auto& record : records)
+    {
+        Entry entry{};
+        entry.key_offset    = static_cast<std::uint32_t>(pool_size);
+        entry.key_size      = static_cast<std::uint32_t>(record.first.size());
+        entry.contents_size = static_cast<std::uint32_t>(record.second.size());
+        pool_size += record.first.size() + record.second.size();
+        entries.push_back(entry);
+    }
+
+    if(pool_size > std::numeric_limits<std::uint32_t>::max())
+        return false;
+
+    header.pool_size = pool_size;
+
+    binary.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    binary.write(reinterpret_cast<const char*>(entries.data()), sizeof(Entry) * entries.size());
+
+    for(const auto& record : records)
+    {
+        binary.write(record.first.data(), record.first.size());
+        binary.write(record.second.data(), record.second.size());
+    }
+    return true;
+}
+
+} // namespace binary_db
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BINARY_DB_FORMAT_HPP_
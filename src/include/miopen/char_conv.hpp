@@ -0,0 +1,157 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_CHAR_CONV_HPP
+#define GUARD_MIOPEN_CHAR_CONV_HPP
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace miopen {
+
+/// Locale-independent conversions used for db keys and values. A subset of C++17 <charconv>
+/// that fits C++14.
+
+/// Parses a decimal integer occupying the whole [first, last) range, i.e. leading spaces,
+/// '+' and trailing characters are errors. Returns false on errors and on overflow, value is
+/// not changed then.
+template <class T>
+bool FromChars(const char* first, const char* last, T& value)
+{
+    static_assert(std::is_integral<T>{} && !std::is_same<T, bool>{}, "Integers only");
+
+    const auto negative = std::is_signed<T>{} && first != last && *first == '-';
+    if(negative)
+        ++first;
+    if(first == last)
+        return false;
+
+    using U     = typename std::make_unsigned<T>::type;
+    const U max = negative ? U(U(std::numeric_limits<T>::max()) + 1U)
+                           : U(std::numeric_limits<T>::max());
+    U result = 0;
+
+    for(; first != last; ++first)
+    {
+        const auto digit = static_cast<unsigned>(*first - '0');
+        if(digit > 9 || result > (max - digit) / 10)
+            return false;
+        result = result * 10 + digit;
+    }
+
+    value = negative ? static_cast<T>(0 - result) : static_cast<T>(result);
+    return true;
+}
+
+/// Appends the decimal representation of an integer.
+template <class T>
+void AppendChars(std::string& str, T value)
+{
+    static_assert(std::is_integral<T>{}, "Integers only");
+
+    using U = typename std::make_unsigned<T>::type;
+    char buffer[std::numeric_limits<U>::digits10 + 2];
+    const auto last     = buffer + sizeof(buffer);
+    auto first          = last;
+    auto magnitude      = static_cast<U>(value);
+    const auto negative = std::is_signed<T>{} && value < T{0};
+
+    if(negative)
+        magnitude = static_cast<U>(U(0) - magnitude);
+    do
+    {
+        *--first = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while(magnitude != 0);
+    if(negative)
+        *--first = '-';
+
+    str.append(first, last);
+}
+
+/// Replacement of std::ostringstream for serialization of db keys and values. Appends to a
+/// string reserved up front, so that neither locales nor stream state are involved and the
+/// result is usually built with a single allocation. Types other than characters, strings and
+/// integers are formatted via std::ostringstream.
+class TextWriter
+{
+    public:
+    explicit TextWriter(std::size_t capacity = 64) { buffer.reserve(capacity); }
+
+    TextWriter& operator<<(char c)
+    {
+        buffer.push_back(c);
+        return *this;
+    }
+
+    TextWriter& operator<<(const char* str)
+    {
+        buffer.append(str);
+        return *this;
+    }
+
+    TextWriter& operator<<(const std::string& str)
+    {
+        buffer.append(str);
+        return *this;
+    }
+
+    template <class T>
+    auto operator<<(T value) ->
+        typename std::enable_if<std::is_integral<T>{} && !std::is_same<T, char>{} &&
+                                    !std::is_same<T, bool>{},
+                                TextWriter&>::type
+    {
+        AppendChars(buffer, value);
+        return *this;
+    }
+
+    template <class T>
+    auto operator<<(const T& value) ->
+        typename std::enable_if<!std::is_integral<T>{} &&
+                                    !std::is_convertible<const T&, const char*>{} &&
+                                    !std::is_convertible<const T&, const std::string&>{},
+                                TextWriter&>::type
+    {
+        std::ostringstream ss;
+        ss << value;
+        buffer.append(ss.str());
+        return *this;
+    }
+
+    TextWriter& operator<<(bool value) { return *this << (value ? '1' : '0'); }
+
+    const std::string& str() const { return buffer; }
+    std::string Release() { return std::move(buffer); }
+
+    private:
+    std::string buffer;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CHAR_CONV_HPP
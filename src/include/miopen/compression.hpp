@@ -0,0 +1,47 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPRESSION_HPP
+#define GUARD_MIOPEN_COMPRESSION_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+
+/// Compresses the data into the LZ4 block format.
+/// Used by addkernels to embed the kernel sources, so it depends on the standard library only.
+std::vector<unsigned char> CompressBlock(const char* data, std::size_t size);
+
+/// Decompresses a block produced by CompressBlock() into exactly dst_size bytes.
+/// Returns false if the block is malformed or does not decompress to dst_size bytes.
+bool DecompressBlock(const unsigned char* src,
+                     std::size_t src_size,
+                     char* dst,
+                     std::size_t dst_size);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPRESSION_HPP
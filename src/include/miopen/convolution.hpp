@@ -181,6 +181,18 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                          bool exhaustiveSearch,
                          int direction) const;
 
+    void PrecompileDirectKernels(Handle& handle,
+                                 const TensorDescriptor& xDesc,
+                                 const TensorDescriptor& wDesc,
+                                 const TensorDescriptor& yDesc,
+                                 bool exhaustiveSearch,
+                                 int direction) const;
+
+    void PrecompileForward(Handle& handle,
+                           const TensorDescriptor& xDesc,
+                           const TensorDescriptor& wDesc,
+                           const TensorDescriptor& yDesc) const;
+
     void ConvolutionForward(Handle& handle,
                             const void* alpha,
                             const TensorDescriptor& xDesc,
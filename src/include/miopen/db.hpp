@@ -31,18 +31,60 @@
 
 #include <boost/optional.hpp>
 
+#include <cstdint>
+#include <ctime>
 #include <string>
+#include <vector>
 
 namespace miopen {
 
 struct RecordPositions;
+struct RecordReplacement;
 class LockFile;
 
+/// Identifies a version of a file: changes whenever the file is written or replaced.
+struct FileStamp
+{
+    std::uintmax_t size = 0;
+    std::time_t mtime   = 0;
+    long mtime_nsec     = 0;
+    std::uintmax_t node = 0;
+
+    bool operator==(const FileStamp& other) const
+    {
+        return size == other.size && mtime == other.mtime && mtime_nsec == other.mtime_nsec &&
+               node == other.node;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+/// Gets the stamp of FILENAME. Returns false if the file does not exist.
+bool GetFileStamp(const std::string& filename, FileStamp& stamp);
+
+/// Controls how changes are written to a db file.
+enum class DbWriteMode
+{
+    /// Snapshot if MIOPEN_PERFDB_SNAPSHOT is enabled, otherwise Journal if MIOPEN_PERFDB_JOURNAL
+    /// is enabled, Rewrite otherwise.
+    Default,
+    /// A changed record is replaced in place, so the whole file is rewritten.
+    Rewrite,
+    /// Changed and removed records are appended to the end of the file ("KEY=" for removal)
+    /// and the last line with a KEY wins. The file is compacted once the dead lines
+    /// outnumber the live records, or by Compact().
+    Journal,
+    /// Each change publishes a new snapshot of the file: a copy is written to a temp file,
+    /// flushed to the disk and renamed over the db. Readers always see a complete snapshot, so
+    /// they do not lock the file and are never blocked by writers. All the processes using
+    /// the file shall be in this mode.
+    Snapshot,
+};
+
 /// No instance of this class should be used from several threads at the same time.
 class Db
 {
     public:
-    Db(const std::string& filename_);
+    Db(const std::string& filename_, DbWriteMode write_mode_ = DbWriteMode::Default);
 
     /// Searches db for provided key and returns found record or none if key not found in database
     boost::optional<DbRecord> FindRecord(const std::string& key);
@@ -54,6 +96,13 @@ class Db
         return FindRecord(key);
     }
 
+    /// Searches db for the record with VALUES under the ID and the key closest by DISTANCE.
+    /// Equally close keys are ordered lexicographically.
+    ///
+    /// Returns none if there is no such record.
+    boost::optional<DbRecord> FindClosestRecord(const std::string& id,
+                                                const DbKeyDistance& distance);
+
     /// Stores provided record in database. If record with same key is already in database it is
     /// replaced by provided record.
     ///
@@ -111,6 +160,93 @@ class Db
             return boost::none;
     }
 
+    /// Buffers changes of a db in memory and applies all of them at once on Commit(): under a
+    /// single exclusive lock and with a single pass over the file, instead of locking and
+    /// writing the file on each change. Changes are applied in order of calls, with the same
+    /// semantics as respective members of Db. Changes that are not committed are dropped.
+    ///
+    /// No instance of this class should be used from several threads at the same time.
+    class Transaction
+    {
+        public:
+        Transaction(Db& db_) : db(db_) {}
+
+        /// See Db::StoreRecord().
+        void StoreRecord(const DbRecord& record) { changes.push_back({Kind::Store, record, {}}); }
+
+        /// See Db::UpdateRecord().
+        void UpdateRecord(const DbRecord& record) { changes.push_back({Kind::Update, record, {}}); }
+
+        /// See Db::RemoveRecord().
+        void RemoveRecord(const std::string& key)
+        {
+            changes.push_back({Kind::RemoveRecord, Db::MakeRecord(key), {}});
+        }
+
+        /// See Db::Remove().
+        void Remove(const std::string& key, const std::string& id)
+        {
+            changes.push_back({Kind::Remove, Db::MakeRecord(key), id});
+        }
+
+        template <class T>
+        inline void RemoveRecord(const T& problem_config)
+        {
+            changes.push_back({Kind::RemoveRecord, DbRecord(problem_config), {}});
+        }
+
+        template <class T>
+        inline void Remove(const T& problem_config, const std::string& id)
+        {
+            changes.push_back({Kind::Remove, DbRecord(problem_config), id});
+        }
+
+        /// See Db::Update().
+        template <class T, class V>
+        inline void Update(const T& problem_config, const std::string& id, const V& values)
+        {
+            DbRecord record(problem_config);
+            record.SetValues(id, values);
+            UpdateRecord(record);
+        }
+
+        /// Number of changes buffered since construction or the last Commit().
+        std::size_t Size() const { return changes.size(); }
+
+        /// Applies the buffered changes to the db.
+        ///
+        /// Returns true if all the changes were written successfully, false otherwise.
+        /// Either way, the buffer is empty after the call.
+        bool Commit();
+
+        private:
+        enum class Kind
+        {
+            Store,
+            Update,
+            RemoveRecord,
+            Remove,
+        };
+
+        struct Change
+        {
+            Kind kind;
+            DbRecord record;
+            std::string id;
+        };
+
+        Db& db;
+        std::vector<Change> changes;
+
+        friend class Db;
+    };
+
+    /// Rewrites the file leaving exactly one line per record, i.e. drops lines of removed and
+    /// replaced records and ill-formed lines.
+    ///
+    /// Returns true if compaction was successful, false otherwise.
+    bool Compact();
+
     /// Searches for record with key PROBLEM_CONFIG and gets VALUES under the ID from it.
     /// Class T should have "void Serialize(std::ostream&) const" member function available.
     /// Class V shall have "bool Deserialize(const std::string& str)" member function available.
@@ -130,12 +266,20 @@ class Db
     private:
     std::string filename;
     LockFile& lock_file;
+    DbWriteMode write_mode;
 
     boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
+    bool AppendUnsafe(const DbRecord& record, bool exists);
+    bool RewriteUnsafe(const std::vector<RecordReplacement>& replaced,
+                       const std::vector<const DbRecord*>& appended);
+    bool CompactUnsafe();
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
+    bool CommitUnsafe(const std::vector<Transaction::Change>& changes);
+
+    static DbRecord MakeRecord(const std::string& key) { return {key}; }
 
     template <class T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
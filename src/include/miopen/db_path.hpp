@@ -32,6 +32,10 @@ namespace miopen {
 
 std::string GetDbPath();
 
+/// Returns the directory of the user's writable dbs or an empty string if there is none,
+/// in which case the installed dbs are written.
+std::string GetUserDbPath();
+
 } // namespace miopen
 
 #endif
@@ -27,11 +27,16 @@
 #define GUARD_MIOPEN_DB_RECORD_HPP_
 
 #include <miopen/config.h>
+#include <miopen/char_conv.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/rank.hpp>
 
+#include <boost/container/small_vector.hpp>
+
+#include <functional>
 #include <sstream>
 #include <string>
-#include <unordered_map>
+#include <utility>
 
 namespace miopen {
 
@@ -66,34 +71,65 @@ namespace miopen {
 class DbRecord
 {
     private:
+    /// Records rarely have more than a couple of IDs, so a flat vector searched linearly beats
+    /// a hash map and usually needs no allocations besides the strings.
+    using Contents = boost::container::small_vector<std::pair<std::string, std::string>, 2>;
+
     std::string key;
-    std::unordered_map<std::string, std::string> map;
+    Contents map;
 
     template <class T>
-    static // 'static' is for calling from ctor
-        std::string
-        Serialize(const T& data)
+    static auto Serialize(rank<1>, const T& data)
+        -> decltype(data.Serialize(std::declval<TextWriter&>()), std::string())
+    {
+        TextWriter writer;
+        data.Serialize(writer);
+        return writer.Release();
+    }
+
+    template <class T>
+    static std::string Serialize(rank<0>, const T& data)
     {
         std::ostringstream ss;
         data.Serialize(ss);
         return ss.str();
     }
 
-    bool ParseContents(const std::string& contents);
-    void WriteContents(std::ostream& stream) const;
+    template <class T>
+    static // 'static' is for calling from ctor
+        std::string
+        Serialize(const T& data)
+    {
+        return Serialize(rank<1>{}, data);
+    }
+
     bool SetValues(const std::string& id, const std::string& values);
-    bool GetValues(const std::string& id, std::string& values) const;
+    const std::string* FindValues(const std::string& id) const;
 
+    public:
+    /// Creates an empty record with the KEY given as is.
     DbRecord(const std::string& key_) : key(key_) {}
 
-    public:
     /// T shall provide a db KEY by means of the "void Serialize(std::ostream&) const" member
-    /// function.
+    /// function. A template Serialize() accepting miopen::TextWriter is preferred if available.
     template <class T>
     DbRecord(const T& problem_config_) : DbRecord(Serialize(problem_config_))
     {
     }
 
+    const std::string& GetKey() const { return key; }
+
+    /// ID:VALUES pairs of the record, in order of addition.
+    const Contents& GetContents() const { return map; }
+
+    /// Replaces the contents with the ones read from the text db format: "ID:VALUES;ID:VALUES".
+    /// Returns false if there are no well-formed pairs.
+    bool ParseContents(const std::string& contents);
+
+    /// Writes the record as a line of the text db: "KEY=ID:VALUES;ID:VALUES". Writes nothing
+    /// if the record is empty.
+    void WriteContents(std::ostream& stream) const;
+
     /// Merges data from this record to data from that record if their keys are same.
     /// This record would contain all ID:VALUES pairs from that record that are not in this.
     /// E.g. this = {ID1:VALUE1}
@@ -121,13 +157,14 @@ class DbRecord
     template <class T>
     bool GetValues(const std::string& id, T& values) const
     {
-        std::string s;
-        if(!GetValues(id, s))
+        const auto s = FindValues(id);
+        if(s == nullptr)
             return false;
 
-        const bool ok = values.Deserialize(s);
+        MIOPEN_LOG_I("Read record " << key << '=' << id << ':' << *s);
+        const bool ok = values.Deserialize(*s);
         if(!ok)
-            MIOPEN_LOG(LoggingLevel::Error, "deserialize failed: " << s);
+            MIOPEN_LOG(LoggingLevel::Error, "deserialize failed: " << *s);
         return ok;
     }
 
@@ -137,7 +174,13 @@ class DbRecord
     bool EraseValues(const std::string& id);
 
     friend class Db;
+    friend class BinaryDb;
+    friend class MultiFileDb;
 };
+
+/// Distance from a KEY to the one being searched for by FindClosestRecord() of dbs.
+/// Shall be non-negative, or infinite for keys which shall not be considered.
+using DbKeyDistance = std::function<double(const std::string& key)>;
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_DB_RECORD_HPP_
@@ -0,0 +1,75 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_EMBEDDED_KERNELS_HPP
+#define GUARD_MIOPEN_EMBEDDED_KERNELS_HPP
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+/// Kernel source embedded by addkernels into miopen_kernels.h.
+struct EmbeddedKernel
+{
+    const char* name; // Upper case base name of the file.
+    const unsigned char* data;
+    std::size_t size;
+    std::size_t compressed_size; // 0 if the data is stored as is.
+    bool includes;               // Has .include directives of other embedded files.
+};
+
+/// FNV-1a of the upper case name. addkernels picks the seeds that make the table of the embedded
+/// kernels a minimal perfect hash: a bucket selected with seed 0 either holds a negative
+/// displacement -(slot + 1) or the seed that puts its names into free slots.
+constexpr std::uint32_t EmbeddedKernelHash(const char* name, std::size_t length, std::uint32_t seed)
+{
+    std::uint32_t hash = seed == 0 ? 0x811c9dc5u : seed;
+    for(std::size_t i = 0; i < length; ++i)
+    {
+        auto c = static_cast<unsigned char>(name[i]);
+        if(c >= 'a' && c <= 'z')
+            c = static_cast<unsigned char>(c - 'a' + 'A');
+        hash = (hash ^ c) * 0x01000193u;
+    }
+    return hash;
+}
+
+/// Name of an embedded file included by the assembly kernels, e.g. COMMON_INC for common.inc.
+inline std::string EmbeddedIncludeName(const std::string& path)
+{
+    std::string result;
+    for(const auto c : path)
+        result += std::isalnum(static_cast<unsigned char>(c))
+                      ? static_cast<char>(std::toupper(static_cast<unsigned char>(c)))
+                      : '_';
+    return result;
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_EMBEDDED_KERNELS_HPP
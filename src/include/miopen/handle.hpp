@@ -26,15 +26,20 @@
 #ifndef GUARD_MIOPEN_CONTEXT_HPP_
 #define GUARD_MIOPEN_CONTEXT_HPP_
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <future>
 #include <memory>
 #include <miopen/common.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/kernel_key.hpp>
+#include <miopen/kernel_trace.hpp>
+#include <miopen/memory_pool.hpp>
 #include <miopen/miopen.h>
 #include <miopen/object.hpp>
 #include <miopen/allocator.hpp>
-#include <miopen/simple_hash.hpp>
+#include <miopen/workspace_arena.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <vector>
 #include <unordered_map>
@@ -43,7 +48,7 @@ namespace miopen {
 
 struct HandleImpl;
 struct GemmGeometry;
-using GemmKey = std::pair<std::string, std::string>;
+class MultiFileDb;
 
 struct Handle : miopenHandle
 {
@@ -60,6 +65,36 @@ struct Handle : miopenHandle
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
 
+    /// Sets the bytes of released buffers that Create() keeps for reuse, 0 to free them at once.
+    /// SetAllocator() resets it: the buffers of a custom allocator are not kept by default.
+    void SetMemoryPoolCapacity(std::size_t capacity) const;
+    /// Frees the buffers kept for reuse.
+    void TrimMemoryPool() const;
+    MemoryPoolStats GetMemoryPoolStats() const;
+
+    /// Lets the ops that are given no workspace use the workspace arena of the handle, which grows
+    /// to the largest workspace needed, up to the limit. A limit of 0 disables the arena.
+    void EnableWorkspaceArena(std::size_t limit);
+    /// 0 if the arena is disabled.
+    std::size_t GetWorkspaceArenaLimit() const;
+    /// A workspace of sz bytes from the arena, which must be enabled. Workspaces that are in use
+    /// at once are sub-buffers of the arena, given back last in first out.
+    Workspace GetWorkspace(std::size_t sz);
+
+    /// Gives an op that is given no workspace one from the arena, if it is enabled, of the size
+    /// returned by get_size() but not above the limit. The op must run before it is released.
+    template <class F>
+    Workspace UseWorkspaceArena(void*& workspace, std::size_t& workspace_size, F get_size)
+    {
+        const auto limit = this->GetWorkspaceArenaLimit();
+        if(workspace != nullptr || limit == 0)
+            return {};
+        auto result    = this->GetWorkspace(std::min<std::size_t>(get_size(), limit));
+        workspace      = result.Get();
+        workspace_size = result.GetSize();
+        return result;
+    }
+
     void EnableProfiling(bool enable = true);
 
     void ResetKernelTime();
@@ -68,6 +103,26 @@ struct Handle : miopenHandle
     float GetKernelTime() const;
     bool IsProfilingEnabled() const;
 
+    /// Records the last launches of kernels, with their times, without waiting for the kernels.
+    /// A capacity of 0 disables the trace and drops it. Not supported by the HIP backend.
+    void EnableKernelTrace(std::size_t capacity);
+    /// Waits for the kernels of the trace. Empty if the trace is disabled.
+    std::vector<KernelTraceEntry> GetKernelTrace();
+
+    /// While enabled, AddKernel() only starts building the program of the kernel, the returned
+    /// invocation does not launch it, and GetKernels() finds nothing. Running a layer in this
+    /// mode compiles its kernels ahead of time.
+    void EnablePrecompileOnly(bool enable = true);
+    bool IsPrecompileOnlyEnabled() const;
+
+    KernelInvoke AddKernel(const KernelKey& key,
+                           const std::string& program_name,
+                           const std::string& kernel_name,
+                           const std::vector<size_t>& vld,
+                           const std::vector<size_t>& vgd,
+                           const std::string& params,
+                           std::size_t cache_index = 0);
+
     KernelInvoke AddKernel(const std::string& algorithm,
                            const std::string& network_config,
                            const std::string& program_name,
@@ -75,30 +130,99 @@ struct Handle : miopenHandle
                            const std::vector<size_t>& vld,
                            const std::vector<size_t>& vgd,
                            const std::string& params,
-                           std::size_t cache_index = 0);
+                           std::size_t cache_index = 0)
+    {
+        return this->AddKernel(KernelKey{algorithm, network_config},
+                               program_name,
+                               kernel_name,
+                               vld,
+                               vgd,
+                               params,
+                               cache_index);
+    }
 
+    auto GetKernels(const KernelKey& key)
+    {
+        return this->GetKernelsImpl(key) |
+               boost::adaptors::transformed([this, key](Kernel k) { return this->Run(k, key); });
+    }
     auto GetKernels(const std::string& algorithm, const std::string& network_config)
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        return this->GetKernels(KernelKey{algorithm, network_config});
     }
-    KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config)
+    KernelInvoke GetKernel(const KernelKey& key)
     {
-        auto ks = this->GetKernelsImpl(algorithm, network_config);
+        auto ks = this->GetKernelsImpl(key);
         if(ks.empty())
         {
-            MIOPEN_THROW("looking for default kernel (does not exist): " + algorithm + ", " +
-                         network_config);
+            MIOPEN_THROW("looking for default kernel (does not exist): " + key.ToString());
         }
-        return this->Run(ks.front());
+        return this->Run(ks.front(), key);
+    }
+    KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config)
+    {
+        return this->GetKernel(KernelKey{algorithm, network_config});
     }
 
     KernelInvoke Run(Kernel k);
+    /// The key names the launches of the kernel in the kernel trace.
+    KernelInvoke Run(Kernel k, const KernelKey& key);
+    const std::vector<Kernel>& GetKernelsImpl(const KernelKey& key);
     const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config);
+                                              const std::string& network_config)
+    {
+        return this->GetKernelsImpl(KernelKey{algorithm, network_config});
+    }
 
     Program LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str);
 
+    /// Starts building the program in the background, so that a subsequent
+    /// AddKernel() for it does not have to wait for the whole build.
+    void PrecompileProgram(const std::string& program_name,
+                           const std::string& params,
+                           bool is_kernel_str = false);
+    /// Waits for the programs started by PrecompileProgram().
+    /// Returns the number of programs built and sets the number of failed ones.
+    std::size_t WaitForPrecompiled(std::size_t& failed);
+
+    /// Records the kernels launched with the handle and the buffers copied by Copy(), which
+    /// still run as usual, until EndRecording(). A transfer from or to the host memory
+    /// meanwhile makes the recording not replayable. The HIP backend records nothing.
+    void BeginRecording();
+    /// Keeps the launches recorded since BeginRecording() under the key, to be replayed with
+    /// other buffers in place of these ones. Nothing is kept if the launches use other buffers.
+    void EndRecording(const KernelKey& key, const std::vector<ConstData_t>& buffers);
+    void CancelRecording();
+    /// Launches the kernels recorded under the key again, each buffer in place of the one at the
+    /// same position at EndRecording(). Returns false if nothing is recorded under the key.
+    bool Replay(const KernelKey& key, const std::vector<ConstData_t>& buffers);
+
+    /// Replays the launches recorded under the key, or calls f and records the launches it
+    /// makes. The key must identify everything but the buffers that the launches depend on.
+    template <class F>
+    void RecordOrReplay(const KernelKey& key, const std::vector<ConstData_t>& buffers, F f)
+    {
+        if(this->IsProfilingEnabled())
+        {
+            f();
+            return;
+        }
+        if(this->Replay(key, buffers))
+            return;
+
+        this->BeginRecording();
+        try
+        {
+            f();
+        }
+        catch(...)
+        {
+            this->CancelRecording();
+            throw;
+        }
+        this->EndRecording(key, buffers);
+    }
+
     void Finish() const;
     void Flush() const;
 
@@ -109,10 +233,19 @@ struct Handle : miopenHandle
 
     void Copy(ConstData_t src, Data_t dest, std::size_t size);
 
+    /// Ready once a transfer is done. Waiting for it throws if the transfer failed.
+    using Transfer = std::shared_future<void>;
+
     Allocator::ManageDataPtr Create(std::size_t sz);
     Allocator::ManageDataPtr&
     WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz);
     void ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz);
+    /// Writes to the buffer after the work already enqueued, without waiting for either.
+    /// The data must stay valid until the transfer is done.
+    Transfer WriteToAsync(const void* data, Data_t ddata, std::size_t sz);
+    /// Reads the buffer after the work already enqueued, without waiting for either.
+    /// The data is only valid once the transfer is done.
+    Transfer ReadToAsync(void* data, ConstData_t ddata, std::size_t sz);
     shared<Data_t> CreateSubBuffer(Data_t data, std::size_t offset, std::size_t size);
 #if MIOPEN_BACKEND_HIP
     shared<ConstData_t> CreateSubBuffer(ConstData_t data, std::size_t offset, std::size_t size);
@@ -142,7 +275,26 @@ struct Handle : miopenHandle
     }
 
     std::unique_ptr<HandleImpl> impl;
-    std::unordered_map<GemmKey, std::unique_ptr<GemmGeometry>, SimpleHash> geo_map;
+    std::unordered_map<KernelKey, std::unique_ptr<GemmGeometry>, KernelKey::Hash> geo_map;
+    /// The perf db of the device, see ConvolutionContext::GetPerfDb().
+    MultiFileDb* perf_db = nullptr;
+};
+
+/// Keeps the handle in the precompile-only mode, see Handle::EnablePrecompileOnly().
+struct AutoPrecompileOnly
+{
+    AutoPrecompileOnly(Handle& h) : handle(h), buffer(h.Create(1))
+    {
+        handle.EnablePrecompileOnly();
+    }
+    ~AutoPrecompileOnly() { handle.EnablePrecompileOnly(false); }
+
+    /// Stands for every buffer of the layer, as its kernels are not launched.
+    Data_t GetBuffer() const { return buffer.get(); }
+
+    private:
+    Handle& handle;
+    Allocator::ManageDataPtr buffer;
 };
 } // namespace miopen
 MIOPEN_DEFINE_OBJECT(miopenHandle, miopen::Handle);
@@ -142,6 +142,8 @@ struct HIPOCKernelInvoke
     template <class... Ts>
     void operator()(Ts... xs) const
     {
+        if(fun == nullptr)
+            return; // See Handle::EnablePrecompileOnly()
         KernelArgs<Ts...> args{xs...};
         run(&args, sizeof(args));
     }
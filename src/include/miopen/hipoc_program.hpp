@@ -39,7 +39,8 @@ struct HIPOCProgram
 {
     HIPOCProgram();
     HIPOCProgram(const std::string& program_name, std::string params, bool is_kernel_str);
-    HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco);
+    /// Loads the program from the contents of a code object, e.g. from the binary cache.
+    HIPOCProgram(const std::string& program_name, const std::string& hsaco);
     std::shared_ptr<const HIPOCProgramImpl> impl;
     hipModule_t GetModule() const;
     boost::filesystem::path GetBinary() const;
@@ -45,8 +45,13 @@
 
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/kernel_key.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -56,18 +61,35 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * Kernels are private to the cache of a handle, programs may be shared by the handles of the
+ * same context and device, see SharePrograms().
  */
 class KernelCache
 {
 
     public:
-    using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using Key        = KernelKey;
+    using ProgramKey = std::pair<std::string, std::string>;
+    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, Key::Hash>;
+    using ProgramMap = std::unordered_map<ProgramKey, std::shared_future<Program>, SimpleHash>;
+
+    /// Builds the program or loads it from the binary cache. It must not use the handle, as it
+    /// may be called from a background thread while the handle is in use.
+    using ProgramLoader = std::function<Program(
+        const std::string& program_name, const std::string& params, bool is_kernel_str)>;
+
+    struct SharedPrograms
+    {
+        std::mutex mutex;
+        ProgramMap programs;
+    };
+
+    /// Makes the cache use the programs of the other caches of the context and device, for as
+    /// long as any of them exists. The programs are private to the cache until called.
+    void SharePrograms(const void* context, const void* device);
 
     Kernel AddKernel(Handle& h,
-                     const std::string& algorithm,
-                     const std::string& network_config,
+                     const Key& key,
                      const std::string& program_name,
                      const std::string& kernel_name,
                      const std::vector<size_t>& vld,
@@ -75,16 +97,41 @@ class KernelCache
                      std::string params      = "",
                      std::size_t cache_index = 0);
 
-    void AddKernel(Key key, Kernel k, std::size_t cache_index);
+    void AddKernel(const Key& key, Kernel k, std::size_t cache_index);
+
+    /// Starts building the program in the background, unless it is already built or being
+    /// built. AddKernel() waits for the build only if the program is not ready yet.
+    /// Builds it in the calling thread if background compilation is disabled by
+    /// MIOPEN_COMPILE_PARALLEL_LEVEL=0. Build errors are reported by AddKernel().
+    void Precompile(const ProgramLoader& load,
+                    const std::string& program_name,
+                    std::string params,
+                    bool is_kernel_str = false);
+
+    struct PrecompileResult
+    {
+        std::size_t built  = 0;
+        std::size_t failed = 0;
+    };
+
+    /// Waits for the programs started by Precompile() since the previous call.
+    /// Failed programs are logged and forgotten, so AddKernel() would build them again.
+    PrecompileResult WaitForPrecompiled();
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    const std::vector<Kernel>& GetKernels(const Key& key);
 
     KernelCache();
+    KernelCache(const KernelCache&) = delete;
+    KernelCache& operator=(const KernelCache&) = delete;
+    /// Waits for the programs it started building, as they refer to the handle.
+    ~KernelCache();
 
     private:
     KernelMap kernel_map;
-    ProgramMap program_map;
+    std::shared_ptr<SharedPrograms> programs;
+    std::vector<ProgramKey> precompiled;
+    /// Background builds started by this cache, as they refer to its handle.
+    std::vector<std::shared_future<Program>> started;
 };
 
 } // namespace miopen
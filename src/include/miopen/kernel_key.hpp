@@ -0,0 +1,110 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_KEY_HPP
+#define GUARD_MIOPEN_KERNEL_KEY_HPP
+
+#include <boost/container/small_vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+namespace miopen {
+
+/// Interned name of the algorithm a kernel is cached for. Interning takes a lock and a string
+/// lookup, so the hot paths keep the object in a static and compare ids afterwards.
+class KernelAlgorithm
+{
+    public:
+    explicit KernelAlgorithm(const std::string& name);
+
+    const std::string& GetName() const;
+    std::size_t GetId() const { return id; }
+
+    friend bool operator==(const KernelAlgorithm& l, const KernelAlgorithm& r)
+    {
+        return l.id == r.id;
+    }
+    friend bool operator!=(const KernelAlgorithm& l, const KernelAlgorithm& r)
+    {
+        return !(l == r);
+    }
+
+    private:
+    std::size_t id;
+};
+
+/// Key of the kernel cache: the algorithm and the network config of the problem, as integers.
+/// Building, comparing and hashing a key of up to 24 fields does not allocate memory.
+class KernelKey
+{
+    public:
+    using Field  = std::int64_t;
+    using Fields = boost::container::small_vector<Field, 24>;
+
+    KernelKey(const KernelAlgorithm& algorithm_, std::initializer_list<Field> fields_);
+    /// Key of a varying number of fields, e.g. one per step of a sequence.
+    KernelKey(const KernelAlgorithm& algorithm_, Fields fields_);
+    /// Legacy network config string, stored 8 characters per field.
+    KernelKey(const KernelAlgorithm& algorithm_, const std::string& network_config);
+    KernelKey(const std::string& algorithm_, const std::string& network_config);
+
+    /// Packs up to 8 characters of a short string field, like the tensor layout, into a Field.
+    static Field Pack(const std::string& str);
+    /// Keeps all the bits of a floating point field, unlike std::to_string().
+    static Field Pack(double value);
+
+    const KernelAlgorithm& GetAlgorithm() const { return algorithm; }
+    /// Legacy keys with an empty algorithm or network config, their kernels are not cached.
+    bool IsEmpty() const;
+    std::size_t GetHash() const { return hash; }
+    std::string ToString() const;
+
+    friend bool operator==(const KernelKey& l, const KernelKey& r)
+    {
+        return l.hash == r.hash && l.algorithm == r.algorithm && l.is_string == r.is_string &&
+               l.fields == r.fields;
+    }
+    friend bool operator!=(const KernelKey& l, const KernelKey& r) { return !(l == r); }
+
+    struct Hash
+    {
+        std::size_t operator()(const KernelKey& key) const { return key.GetHash(); }
+    };
+
+    private:
+    KernelAlgorithm algorithm;
+    Fields fields;
+    bool is_string;
+    std::size_t hash;
+
+    void ComputeHash();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERNEL_KEY_HPP
@@ -0,0 +1,85 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_TRACE_HPP
+#define GUARD_MIOPEN_KERNEL_TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Launch of a kernel recorded by the trace of a handle, see Handle::EnableKernelTrace().
+struct KernelTraceEntry
+{
+    std::string kernel_name;
+    std::string network_config;
+    /// Nanoseconds of the device clock, 0 if the queue does not profile.
+    std::uint64_t queued = 0;
+    std::uint64_t start  = 0;
+    std::uint64_t end    = 0;
+};
+
+/// The last launches of the kernels of a handle. A launch is recorded with the event of the
+/// kernel, which is read when the trace is, so that the launches do not wait for the kernels.
+class KernelTrace
+{
+    public:
+    using Event = std::shared_ptr<void>;
+    /// Waits for the event and sets the times of the entry.
+    using ReadEvent = void (*)(void* event, KernelTraceEntry& entry);
+
+    KernelTrace(std::size_t capacity, ReadEvent read_event_);
+
+    /// Overwrites the oldest launch once the trace is full.
+    void Add(std::string kernel_name, std::string network_config, Event event);
+    /// The launches, oldest first.
+    std::vector<KernelTraceEntry> Get();
+
+    private:
+    struct Launch
+    {
+        KernelTraceEntry entry;
+        Event event;
+    };
+
+    std::mutex mutex;
+    ReadEvent read_event;
+    std::vector<Launch> launches;
+    std::size_t next  = 0;
+    std::size_t count = 0;
+};
+
+/// Writes the launches in the Chrome trace event format, for chrome://tracing.
+void WriteChromeTrace(std::ostream& os, const std::vector<KernelTraceEntry>& entries);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERNEL_TRACE_HPP
@@ -0,0 +1,99 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_MEMORY_POOL_HPP
+#define GUARD_MIOPEN_MEMORY_POOL_HPP
+
+#include <miopen/allocator.hpp>
+#include <cstddef>
+#include <limits>
+
+namespace miopen {
+
+struct MemoryPoolStats
+{
+    /// Bytes of the buffers in use.
+    std::size_t in_use = 0;
+    /// Bytes of the released buffers kept for reuse.
+    std::size_t cached = 0;
+    /// The most bytes held from the allocator at once, in use or cached.
+    std::size_t peak = 0;
+    /// Allocations served by cached buffers.
+    std::size_t hits = 0;
+    /// Allocations made with the allocator.
+    std::size_t misses = 0;
+};
+
+/// Keeps the buffers released by their owners, to hand them out again instead of allocating new
+/// ones. Buffers are allocated by size classes, four per power of two, and are reused by
+/// allocations of the same class. The buffers may outlive the pool.
+class MemoryPool
+{
+    public:
+    static constexpr std::size_t Unlimited = std::numeric_limits<std::size_t>::max();
+
+    MemoryPool();
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+    ~MemoryPool();
+
+    /// Frees the cached buffers, and allocates the next buffers with the allocator.
+    void SetAllocator(const Allocator& allocator);
+    /// Bytes of released buffers kept at most. With a capacity of 0 the buffers are allocated
+    /// with their exact size and freed when released, as by the allocator itself.
+    void SetCapacity(std::size_t capacity);
+    std::size_t GetCapacity() const;
+
+    /// A cached buffer for n bytes, or nullptr if there is none.
+    Allocator::ManageDataPtr Reuse(std::size_t n);
+    /// A new buffer for n bytes. If the allocator fails, frees the cached buffers and retries.
+    Allocator::ManageDataPtr Allocate(std::size_t n);
+    Allocator::ManageDataPtr operator()(std::size_t n)
+    {
+        auto result = this->Reuse(n);
+        return result == nullptr ? this->Allocate(n) : std::move(result);
+    }
+
+    /// Frees the cached buffers.
+    void Trim();
+    MemoryPoolStats GetStats() const;
+
+    /// Bytes allocated for a buffer of n bytes.
+    static std::size_t GetSizeClass(std::size_t n);
+    /// A quarter of the memory of the device, so the cached buffers do not starve the
+    /// application, or 0 if MIOPEN_DEBUG_MEMORY_POOL disables the caching of buffers.
+    static std::size_t GetDefaultCapacity(std::size_t device_memory);
+
+    private:
+    struct State;
+    struct Block;
+    static void Release(void* state, void* buffer);
+
+    State* state;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MEMORY_POOL_HPP
@@ -109,7 +109,7 @@ using mlo_kernel_info = std::tuple<const std::string,
 #include <miopen/tensor.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/db_path.hpp>
-#include <miopen/db.hpp>
+#include <miopen/multi_file_db.hpp>
 
 inline int mloLg2(int v)
 {
@@ -198,7 +198,9 @@ struct ProblemDescription
     int GetBackwardPad0() const { return kernel_size0 - pad0 - 1; }
     int GetBackwardPad1() const { return kernel_size1 - pad1 - 1; }
 
-    void Serialize(std::ostream& stream) const
+    /// Stream is either std::ostream or miopen::TextWriter.
+    template <class Stream>
+    void Serialize(Stream& stream) const
     {
         if(!direction.IsKnown())
             MIOPEN_THROW("!direction.IsKnown()");
@@ -220,6 +222,15 @@ struct ProblemDescription
                      : direction.IsBackwardData() ? "B" : "W"); // clang-format on
     }
 
+    /// Restores the problem config from the KEY written by Serialize().
+    /// Returns false if the KEY is ill-formed.
+    bool Deserialize(const std::string& key);
+
+    /// Returns the distance from this problem config to serialized ones. It grows with the
+    /// ratios of respective sizes and is infinite if directions, layouts or data types differ or
+    /// if the other config is ill-formed. This config is parsed once, by this call.
+    DbKeyDistance GetDistance() const;
+
     friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
     {
         obj.Serialize(os);
@@ -273,6 +284,31 @@ struct ConvolutionContext : ProblemDescription
         // clang-format on
     }
 
+    std::string GetUserPerfDbPath() const
+    {
+        const auto user_db_path = GetUserDbPath();
+        if(user_db_path.empty())
+            return {};
+        // clang-format off
+        return user_db_path
+             + std::string("/")
+             + GetStream().GetDeviceName()
+             + "_"
+             + std::to_string(GetStream().GetMaxComputeUnits())
+             + "."
+             + std::string("cd.updb.txt");
+        // clang-format on
+    }
+
+    /// The perf db of the device, resolved once per handle.
+    miopen::MultiFileDb& GetPerfDb() const
+    {
+        auto& handle = GetStream();
+        if(handle.perf_db == nullptr)
+            handle.perf_db = &miopen::MultiFileDb::Get(GetPerfDbPath(), GetUserPerfDbPath());
+        return *handle.perf_db;
+    }
+
     private:
     Handle* _stream = nullptr;
 };
@@ -376,7 +412,7 @@ struct mlo_construct_direct2D
 
     miopen::solver::ConvSolution FindSolution();
 
-    miopen::Db GetDb() const;
+    miopen::MultiFileDb& GetDb() const;
 
     /*
     * returns parameter values that are compiled in legacy kernels for kernels using them as
@@ -804,7 +840,7 @@ struct mlo_construct_direct2D
     }
 
     // MD: Hack to get the key outside of mlo_internal
-    int mloBuildConf_Key(std::string& conf_key) const;
+    miopen::KernelKey mloBuildConf_Key(const miopen::KernelAlgorithm& algorithm) const;
 
     inline bool doCopyInput() const { return (_copy_input); }
 
@@ -0,0 +1,188 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_MULTI_FILE_DB_HPP_
+#define GUARD_MIOPEN_MULTI_FILE_DB_HPP_
+
+#include <miopen/binary_db.hpp>
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace miopen {
+
+/// Perf db made of two layers: the installed db, which is never written, and the user db,
+/// which receives all the changes. Records found in both are merged, with values from the user
+/// db taking precedence (see DbRecord::Merge()).
+///
+/// The installed db is read from the binary db next to the text one ("*.txt" -> "*.bin", see
+/// binary_db_format.hpp) if it is available and from the text db otherwise.
+///
+/// If the path of the user db is empty, the installed text db is the only layer and is written
+/// as is, like a plain Db. This is the case in BUILD_DEV mode.
+///
+/// Results of lookups (including misses) are cached in memory, so repeated lookups do not touch
+/// the files. Changes made via the instance drop the affected results at once. Changes made by
+/// other instances or processes are detected by the stamp of the user db file, which is checked
+/// on each cache miss and at most once a second on hits, or dropped at once by Reload().
+///
+/// All operations are MT-safe: the layers are only accessed under a lock. Use Get() to obtain
+/// the instance shared by the whole process.
+class MultiFileDb
+{
+    public:
+    MultiFileDb(const std::string& installed_path, const std::string& user_path);
+    MultiFileDb(const MultiFileDb&) = delete;
+    MultiFileDb& operator=(const MultiFileDb&) = delete;
+
+    /// Returns the instance for these paths shared by the whole process. It is created on first
+    /// use and lives until the process exits.
+    static MultiFileDb& Get(const std::string& installed_path, const std::string& user_path);
+
+    /// Searches both dbs for provided key and returns the merged record or none if key is not
+    /// found in any of them.
+    boost::optional<DbRecord> FindRecord(const std::string& key);
+
+    template <class T>
+    inline boost::optional<DbRecord> FindRecord(const T& problem_config)
+    {
+        const auto key = DbRecord::Serialize(problem_config);
+        return FindRecord(key);
+    }
+
+    /// See Db::FindClosestRecord(). Returns the merged record, the user's one wins if
+    /// equally close. Results are not cached.
+    boost::optional<DbRecord> FindClosestRecord(const std::string& id,
+                                                const DbKeyDistance& distance);
+
+    /// Like above, but skips the record of KEY itself. Results are cached by KEY and ID, so
+    /// DISTANCE shall depend on KEY only.
+    boost::optional<DbRecord>
+    FindClosestRecord(const std::string& key, const std::string& id, const DbKeyDistance& distance);
+
+    /// See Db::StoreRecord(). Writes to the user db only.
+    bool StoreRecord(const DbRecord& record);
+
+    /// See Db::UpdateRecord(). Writes to the user db only, so provided record is merged with the
+    /// user's one only.
+    bool UpdateRecord(DbRecord& record);
+
+    /// See Db::RemoveRecord(). Removes from the user db only, so the installed record, if any,
+    /// remains visible.
+    bool RemoveRecord(const std::string& key);
+
+    /// See Db::Remove(). Removes from the user db only, so the installed values, if any, remain
+    /// visible.
+    bool Remove(const std::string& key, const std::string& id);
+
+    template <class T>
+    inline bool Remove(const T& problem_config, const std::string& id)
+    {
+        const auto key = DbRecord::Serialize(problem_config);
+        return Remove(key, id);
+    }
+
+    template <class T>
+    inline bool RemoveRecord(const T& problem_config)
+    {
+        const auto key = DbRecord::Serialize(problem_config);
+        return RemoveRecord(key);
+    }
+
+    /// See Db::Update(). Writes to the user db only.
+    template <class T, class V>
+    inline boost::optional<DbRecord>
+    Update(const T& problem_config, const std::string& id, const V& values)
+    {
+        DbRecord record(problem_config);
+        record.SetValues(id, values);
+        const auto ok = UpdateRecord(record);
+        if(ok)
+            return record;
+        else
+            return boost::none;
+    }
+
+    /// See Db::Load(). Values from the user db take precedence.
+    template <class T, class V>
+    inline bool Load(const T& problem_config, const std::string& id, V& values)
+    {
+        const auto record = FindRecord(problem_config);
+
+        if(!record)
+            return false;
+        return record->GetValues(id, values);
+    }
+
+    /// Loads VALUES under the ID from the closest record by DISTANCE to PROBLEM_CONFIG which
+    /// has those. The record of PROBLEM_CONFIG itself is skipped, it is for Load().
+    template <class T, class V>
+    inline bool LoadClosest(const T& problem_config,
+                            const std::string& id,
+                            V& values,
+                            const DbKeyDistance& distance)
+    {
+        const auto key    = DbRecord::Serialize(problem_config);
+        const auto record = FindClosestRecord(key, id, distance);
+
+        if(!record)
+            return false;
+        return record->GetValues(id, values);
+    }
+
+    /// Drops the cached results, so the changes made by other processes are seen right away.
+    void Reload();
+
+    private:
+    boost::optional<BinaryDb> installed_binary;
+    boost::optional<Db> installed_text;
+    Db user;
+    std::string user_file;
+    /// Guards the layers above, Db is not MT-safe.
+    std::mutex db_mutex;
+
+    std::mutex cache_mutex;
+    std::unordered_map<std::string, boost::optional<DbRecord>> cache;
+    /// Maps KEY and ID of closest lookups to the key of the found record.
+    std::map<std::pair<std::string, std::string>, boost::optional<std::string>> closest_cache;
+    /// Stamp of the user db file the cache is valid for.
+    FileStamp cache_stamp;
+    std::chrono::steady_clock::time_point cache_checked;
+    std::size_t invalidations = 0;
+
+    void Invalidate(const std::string& key);
+    void RevalidateCacheUnsafe(bool force);
+};
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MULTI_FILE_DB_HPP_
@@ -28,19 +28,21 @@
 
 #include <algorithm>
 #include <array>
-#include <array>
 #include <cassert>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <miopen/miopen.h>
 #include <numeric>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <miopen/clhelper.hpp>
 #include <miopen/each_args.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/kernel_trace.hpp>
 
 namespace miopen {
 
@@ -56,31 +58,134 @@ struct LocalMemArg
     size_t size;
 };
 
+/// Values of the arguments last set to a kernel. The invocations of the kernel share them, so
+/// that a launch sets only the arguments that have changed since the previous one.
+class OCLKernelArgs
+{
+    public:
+    /// Records the value, or the size of a local memory argument if value is null. Returns false
+    /// if the argument is already set to it.
+    ///
+    /// Not for buffers: the handle of a released buffer may be reused by a new one, so a buffer
+    /// argument is set even if the handle is the same.
+    bool Update(std::size_t i, const void* value, std::size_t size);
+    /// Forgets the argument, e.g. after failing to set it.
+    void Reset(std::size_t i);
+
+    private:
+    struct Arg
+    {
+        bool known       = false;
+        bool local       = false;
+        std::size_t size = 0;
+        std::array<unsigned char, 16> value{};
+    };
+    std::vector<Arg> args;
+};
+
 struct OCLSetKernelArg
 {
     template <class I, class T>
-    void operator()(cl_kernel kernel, I i, const T& x) const
+    void operator()(cl_kernel kernel, OCLKernelArgs* args, I i, const T& x) const
     {
+        if(args != nullptr && !std::is_same<T, cl_mem>{} && !args->Update(i, &x, sizeof(T)))
+            return;
         cl_int status = clSetKernelArg(kernel, i, sizeof(T), reinterpret_cast<const void*>(&x));
         if(status != CL_SUCCESS)
         {
+            if(args != nullptr)
+                args->Reset(i);
             MIOPEN_THROW("Error setting argument #" + std::to_string(i) + " to kernel (size = " +
                          std::to_string(sizeof(T)) + "): " + OpenCLErrorMessage(status));
         }
     }
 
     template <class I>
-    void operator()(cl_kernel kernel, I i, const LocalMemArg& lmem) const
+    void operator()(cl_kernel kernel, OCLKernelArgs* args, I i, const LocalMemArg& lmem) const
     {
+        if(args != nullptr && !args->Update(i, nullptr, lmem.GetSize()))
+            return;
         cl_int status = clSetKernelArg(kernel, i, lmem.GetSize(), NULL);
         if(status != CL_SUCCESS)
         {
+            if(args != nullptr)
+                args->Reset(i);
             MIOPEN_THROW("Error setting argument #" + std::to_string(i) + " to kernel: " +
                          OpenCLErrorMessage(status));
         }
     }
 };
 
+struct OCLKernelInvoke;
+
+/// Kernel launches and buffer copies recorded by a handle, see Handle::BeginRecording(). The
+/// arguments are kept by value; those that are buffers can be replaced when the launches are
+/// replayed.
+class OCLKernelRecording
+{
+    public:
+    void AddLaunch(const OCLKernelInvoke& invoke);
+    /// See Handle::Copy().
+    void AddCopy(cl_mem src, cl_mem dest, std::size_t size);
+    /// Makes the recording not replayable, e.g. after a transfer from or to the host memory,
+    /// which it cannot repeat.
+    void Discard() { discarded = true; }
+
+    template <class T>
+    void AddArg(const T& x)
+    {
+        Arg arg;
+        arg.buffer = std::is_same<T, cl_mem>{};
+        arg.size   = sizeof(T);
+        arg.value.resize(sizeof(T));
+        std::memcpy(arg.value.data(), &x, sizeof(T));
+        launches.back().args.push_back(std::move(arg));
+    }
+    void AddArg(const LocalMemArg& lmem)
+    {
+        Arg arg;
+        arg.size = lmem.GetSize();
+        launches.back().args.push_back(std::move(arg));
+    }
+
+    bool IsActive() const { return active; }
+    /// Stops recording. Returns false if the launches use buffers other than the given ones,
+    /// which the recording cannot replace, or if the recording is discarded.
+    bool Finish(const std::vector<cl_mem>& recorded_buffers);
+    /// Launches the kernels again, each buffer in place of the one at the same position given to
+    /// Finish().
+    void Replay(cl_command_queue queue,
+                const std::vector<cl_mem>& replay_buffers,
+                const std::shared_ptr<KernelTrace>& trace) const;
+
+    private:
+    struct Arg
+    {
+        bool buffer      = false;
+        std::size_t size = 0;
+        std::vector<unsigned char> value; // Empty for local memory.
+    };
+    struct Launch
+    {
+        /// Null for a copy of copy_size bytes from args[0] to args[1].
+        SharedKernelPtr kernel;
+        std::shared_ptr<OCLKernelArgs> kernel_args;
+        size_t work_dim;
+        std::array<size_t, 3> global_work_offset;
+        std::array<size_t, 3> global_work_dim;
+        std::array<size_t, 3> local_work_dim;
+        std::string network_config;
+        std::vector<Arg> args;
+        std::size_t copy_size = 0;
+    };
+    std::vector<Launch> launches;
+    std::vector<cl_mem> buffers;
+    bool active    = true;
+    bool discarded = false;
+
+    cl_mem ReplayBuffer(const Arg& arg, const std::vector<cl_mem>& replay_buffers) const;
+};
+
 struct OCLKernelInvoke
 {
     cl_command_queue queue = nullptr;
@@ -90,14 +195,29 @@ struct OCLKernelInvoke
     std::array<size_t, 3> global_work_dim    = {};
     std::array<size_t, 3> local_work_dim     = {};
     std::function<void(cl_event&)> callback;
+    std::shared_ptr<OCLKernelArgs> args           = nullptr;
+    std::shared_ptr<OCLKernelRecording> recording = nullptr;
+    std::shared_ptr<KernelTrace> trace            = nullptr;
+    std::string network_config; // Of the kernel trace.
 
+    /// Sets the arguments that differ from those of the previous launch of the kernel and
+    /// launches it. The invocation can be kept and called again.
     template <class... Ts>
     void operator()(const Ts&... xs) const
     {
-        each_args_i(
-            std::bind(
-                OCLSetKernelArg{}, kernel.get(), std::placeholders::_1, std::placeholders::_2),
-            xs...);
+        if(kernel == nullptr)
+            return; // See Handle::EnablePrecompileOnly()
+        each_args_i(std::bind(OCLSetKernelArg{},
+                              kernel.get(),
+                              args.get(),
+                              std::placeholders::_1,
+                              std::placeholders::_2),
+                    xs...);
+        if(recording != nullptr && recording->IsActive())
+        {
+            recording->AddLaunch(*this);
+            each_args([this](const auto& x) { recording->AddArg(x); }, xs...);
+        }
         run();
     }
 
@@ -110,9 +230,12 @@ class OCLKernel
 
     public:
     OCLKernel() {}
-    OCLKernel(ClKernelPtr k) : kernel(std::move(k)) {}
+    OCLKernel(ClKernelPtr k) : kernel(std::move(k)), args(std::make_shared<OCLKernelArgs>()) {}
     OCLKernel(ClKernelPtr k, std::vector<size_t> local_dims, std::vector<size_t> global_dims)
-        : kernel(std::move(k)), ldims(std::move(local_dims)), gdims(std::move(global_dims))
+        : kernel(std::move(k)),
+          args(std::make_shared<OCLKernelArgs>()),
+          ldims(std::move(local_dims)),
+          gdims(std::move(global_dims))
     {
         assert(ldims.size() == gdims.size());
         assert(!ldims.empty() && ldims.size() <= 3);
@@ -124,6 +247,7 @@ class OCLKernel
               std::vector<size_t> global_dims)
         : program(p),
           kernel(CreateKernel(p.get(), kernel_name)),
+          args(std::make_shared<OCLKernelArgs>()),
           ldims(std::move(local_dims)),
           gdims(std::move(global_dims))
     {
@@ -149,6 +273,7 @@ class OCLKernel
     private:
     SharedProgramPtr program;
     SharedKernelPtr kernel;
+    std::shared_ptr<OCLKernelArgs> args;
     std::vector<size_t> ldims;
     std::vector<size_t> gdims;
 };
@@ -28,34 +28,59 @@
 #define GUARD_MLOPEN_SERIALIZABLE_HPP
 
 #include <ciso646>
+#include <miopen/char_conv.hpp>
 #include <miopen/config.h>
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace miopen {
 namespace solver {
 
-// TODO: Provide specialization to use stro* functions
-template <class T>
+/// Parses a field of a Serializable from the [first, last) range. Integers and strings are
+/// parsed in place, other types go through a std::stringstream.
+template <class T, class = void>
 struct Parse
 {
-    static bool apply(const std::string& s, T& result)
+    static bool apply(const char* first, const char* last, T& result)
     {
         std::stringstream ss;
-        ss.str(s);
+        ss.str(std::string(first, last));
         ss >> result;
         return true;
     }
 };
 
+template <class T>
+struct Parse<T,
+             typename std::enable_if<std::is_integral<T>{} && !std::is_same<T, bool>{}>::type>
+{
+    static bool apply(const char* first, const char* last, T& result)
+    {
+        return FromChars(first, last, result);
+    }
+};
+
+template <>
+struct Parse<std::string>
+{
+    static bool apply(const char* first, const char* last, std::string& result)
+    {
+        result.assign(first, last);
+        return true;
+    }
+};
+
 template <class Derived, char Seperator = ','>
 struct Serializable
 {
     struct SerializeField
     {
-        template <class T>
-        void operator()(std::ostream& stream, char& sep, const T& x) const
+        template <class Stream, class T>
+        void operator()(Stream& stream, char& sep, const T& x) const
         {
             if(sep != 0)
                 stream << sep;
@@ -67,22 +92,26 @@ struct Serializable
     struct DeserializeField
     {
         template <class T>
-        void operator()(bool& ok, std::istream& stream, char sep, T& x) const
+        void operator()(bool& ok, const char*& first, const char* last, char sep, T& x) const
         {
             if(not ok)
                 return;
-            std::string part;
 
-            if(!std::getline(stream, part, sep))
+            if(first == last)
             {
                 ok = false;
                 return;
             }
 
-            ok = Parse<T>::apply(part, x);
+            const auto end = std::find(first, last, sep);
+            ok             = Parse<T>::apply(first, end, x);
+            first          = end == last ? last : end + 1;
         }
     };
-    void Serialize(std::ostream& stream) const
+
+    /// Stream is either std::ostream or miopen::TextWriter.
+    template <class Stream>
+    void Serialize(Stream& stream) const
     {
         char sep = 0;
         Derived::Visit(
@@ -92,13 +121,16 @@ struct Serializable
 
     bool Deserialize(const std::string& s)
     {
-        auto out = static_cast<const Derived&>(*this);
-        bool ok  = true;
-        std::istringstream ss(s);
-        Derived::Visit(
-            out,
-            std::bind(
-                DeserializeField{}, std::ref(ok), std::ref(ss), Seperator, std::placeholders::_1));
+        auto out          = static_cast<const Derived&>(*this);
+        bool ok           = true;
+        const char* first = s.data();
+        Derived::Visit(out,
+                       std::bind(DeserializeField{},
+                                 std::ref(ok),
+                                 std::ref(first),
+                                 s.data() + s.size(),
+                                 Seperator,
+                                 std::placeholders::_1));
 
         if(!ok)
             return false;
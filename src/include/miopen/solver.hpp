@@ -30,6 +30,7 @@
 #include <miopen/config.h>
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -37,7 +38,7 @@
 
 #include <miopen/logger.hpp>
 #include <miopen/find_controls.hpp>
-#include <miopen/db.hpp>
+#include <miopen/multi_file_db.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/legacy_exhaustive_search.hpp>
 #include <miopen/env.hpp>
@@ -47,6 +48,7 @@
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PERFDB_CLOSEST)
 
 namespace solver {
 
@@ -123,7 +125,7 @@ const std::string& SolverDbId(Solver solver)
 }
 
 template <class Solver, class Context>
-auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
+auto FindSolutionImpl(rank<1>, Solver s, const Context& context, MultiFileDb& db)
     -> decltype(s.GetSolution(context, s.Search(context)))
 {
     const FindEnforce enforce;
@@ -153,6 +155,25 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
                 MIOPEN_LOG_E("Invalid config loaded from Perf Db: " << SolverDbId(s) << ": "
                                                                     << config);
             }
+
+            // The closest record stands in for the missing search results only.
+            if(!(context.do_search || enforce.IsSearch(context)) &&
+               miopen::IsEnabled(MIOPEN_PERFDB_CLOSEST{}))
+            {
+                PerformanceConfig closest{};
+                if(db.LoadClosest(context, SolverDbId(s), closest, context.GetDistance()))
+                {
+                    if(s.IsValidPerformanceConfig(context, closest))
+                    {
+                        MIOPEN_LOG_I("Perf Db: closest record loaded: " << SolverDbId(s));
+                        return s.GetSolution(context, closest);
+                    }
+                    MIOPEN_LOG_I("Invalid config loaded from the closest Perf Db record: "
+                                 << SolverDbId(s)
+                                 << ": "
+                                 << closest);
+                }
+            }
         }
 
         if(context.do_search || enforce.IsSearch(context)) // TODO: Make it a customization point
@@ -174,7 +195,7 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
 }
 
 template <class Solver, class Context>
-auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&)
+auto FindSolutionImpl(rank<0>, Solver s, const Context& context, MultiFileDb&)
     -> decltype(s.GetSolution(context))
 {
     MIOPEN_LOG_I("Not searchable: " << SolverDbId(s));
@@ -188,7 +209,7 @@ auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&)
 /// Could take long if an exhaustive search is requested/performed.
 /// May read/write perfDb.
 template <class Solver, class Context>
-ConvSolution FindSolution(Solver s, const Context& context, Db& db)
+ConvSolution FindSolution(Solver s, const Context& context, MultiFileDb& db)
 {
     static_assert(std::is_empty<Solver>{} && std::is_trivially_constructible<Solver>{},
                   "Solver must be stateless");
@@ -198,7 +219,7 @@ ConvSolution FindSolution(Solver s, const Context& context, Db& db)
 
 // Search for a solution among many solvers
 template <class... Solvers, class Context>
-auto SearchForSolution(const Context& search_params, miopen::Db db) ->
+auto SearchForSolution(const Context& search_params, MultiFileDb& db) ->
     typename std::common_type<decltype(FindSolution(Solvers{}, search_params, db))...>::type
 {
     using Solution =
@@ -228,6 +249,16 @@ auto SearchForSolution(const Context& search_params, miopen::Db db) ->
     return solution;
 }
 
+/// Returns false if VALUES stored in the perf db under the id of a solver are not valid for the
+/// PROBLEM.
+using PerfDbValidator =
+    std::function<bool(const ConvolutionContext& problem, const std::string& values)>;
+
+/// Maps the ids of all the solvers which the library searches for solutions to the validators
+/// of their perf db values. A validator is null if the solver is not searchable, so never
+/// reads the perf db.
+const std::map<std::string, PerfDbValidator>& GetPerfDbValidators();
+
 /// Base class for problem solvers.
 ///
 /// Solvers are to be instantiated as const objects and shall not have any variable
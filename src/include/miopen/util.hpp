@@ -77,7 +77,7 @@ float SubSampleGPU(
     const std::
         tuple<std::string, std::string, std::string, std::vector<size_t>, std::vector<size_t>>&
             kernel_info,
-    std::string& network_config,
+    const KernelKey& key,
     ConstData_t in,
     Data_t out);
 
@@ -0,0 +1,108 @@
+/*******************************************************************************
+*
+* MIT License
+*
+* Copyright (c) 2017 Advanced Micro Devices, Inc.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+*******************************************************************************/
+#ifndef GUARD_MIOPEN_WORKSPACE_ARENA_HPP
+#define GUARD_MIOPEN_WORKSPACE_ARENA_HPP
+
+#include <miopen/allocator.hpp>
+#include <miopen/common.hpp>
+#include <miopen/manage_ptr.hpp>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Scratch memory of an op, see Handle::GetWorkspace(). The kernels enqueued while it is held
+/// may use it.
+struct Workspace
+{
+    Data_t Get() const { return data.get(); }
+    std::size_t GetSize() const { return size; }
+
+    shared<Data_t> data;
+    std::size_t size = 0;
+    /// Gives the memory back to the arena.
+    std::shared_ptr<void> release;
+};
+
+/// Offsets of the workspaces in one buffer, last in first out.
+class WorkspaceStack
+{
+    public:
+    /// Workspaces start at multiples of the alignment, as sub-buffers must.
+    static constexpr std::size_t Alignment = 4096;
+    static constexpr std::size_t NoSpace   = std::numeric_limits<std::size_t>::max();
+
+    /// The offset of sz bytes above the workspaces in use, or NoSpace if they do not fit.
+    std::size_t Push(std::size_t sz);
+    /// Frees the workspace at the offset. Its space is reused once those above it are freed.
+    void Pop(std::size_t offset);
+
+    bool IsEmpty() const { return blocks.empty(); }
+    std::size_t GetCapacity() const { return capacity; }
+    /// Bytes that would have held all the workspaces pushed at once so far.
+    std::size_t GetRequired() const { return required; }
+    /// The stack must be empty.
+    void SetCapacity(std::size_t capacity_);
+
+    private:
+    struct Block
+    {
+        std::size_t offset;
+        std::size_t size;
+        bool used;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t capacity = 0;
+    std::size_t required = 0;
+};
+
+/// Workspaces of the ops of a handle, taken from one buffer. The buffer grows, up to a limit, to
+/// the largest space needed by the workspaces in use at once, when none is in use.
+class WorkspaceArena : public std::enable_shared_from_this<WorkspaceArena>
+{
+    public:
+    WorkspaceArena(std::size_t limit_);
+
+    /// A workspace of sz bytes, of its own if the arena cannot hold it yet.
+    Workspace Get(Handle& handle, std::size_t sz);
+    std::size_t GetLimit() const { return limit; }
+
+    private:
+    std::mutex mutex;
+    std::size_t limit;
+    WorkspaceStack stack;
+    Allocator::ManageDataPtr buffer;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WORKSPACE_ARENA_HPP
@@ -39,15 +39,87 @@
  * limitations under the License.
  * ************************************************************************ */
 
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/thread_pool.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iterator>
+#include <map>
+#include <thread>
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
+
+// Null if background compilation is disabled.
+static ThreadPool* GetCompilePool()
+{
+    static const auto pool = []() -> std::unique_ptr<ThreadPool> {
+        const auto n_threads = GetStringEnv(MIOPEN_COMPILE_PARALLEL_LEVEL{}) == nullptr
+                                   ? std::thread::hardware_concurrency()
+                                   : Value(MIOPEN_COMPILE_PARALLEL_LEVEL{});
+        if(n_threads == 0)
+            return nullptr;
+        MIOPEN_LOG_I2("Compiling kernels in " << n_threads << " threads");
+        return std::make_unique<ThreadPool>(n_threads);
+    }();
+    return pool.get();
+}
+
+static std::shared_ptr<KernelCache::SharedPrograms> GetSharedPrograms(const void* context,
+                                                                      const void* device)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<const void*, const void*>, std::weak_ptr<KernelCache::SharedPrograms>>
+        shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto it = shared.begin(); it != shared.end();)
+        it = it->second.expired() ? shared.erase(it) : std::next(it);
+
+    auto& entry = shared[std::make_pair(context, device)];
+    auto result = entry.lock();
+    if(result == nullptr)
+    {
+        result = std::make_shared<KernelCache::SharedPrograms>();
+        entry  = result;
+    }
+    return result;
+}
+
+// Forgets a failed build, so that the next attempt builds the program again, as the
+// synchronous build would.
+static void EraseFailed(KernelCache::SharedPrograms& shared, const KernelCache::ProgramKey& key)
+{
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    const auto program = shared.programs.find(key);
+    if(program == shared.programs.end() ||
+       program->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return; // Forgotten or being built again.
+    try
+    {
+        program->second.get();
+    }
+    catch(...)
+    {
+        shared.programs.erase(program);
+    }
+}
+
+// Ensure only one space after the -cl-std.
+// >1 space can cause an Apple compiler bug. See clSPARSE issue #141.
+static std::string NormalizeParams(std::string params)
+{
+    if(params.length() > 0 && params.at(0) != ' ')
+        params = " " + params;
+    return params;
+}
+
 #ifndef NDEBUG
 static void dump_kernel_params(const std::string& program_name,
                                const std::string& kernel_name,
@@ -97,21 +169,15 @@ static void dump_kernel_params(const std::string& program_name,
 }
 #endif
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+const std::vector<Kernel>& KernelCache::GetKernels(const Key& key)
 {
-
-    std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-#ifndef NDEBUG
-    std::cout << "key: " << key.first << " " << key.second << std::endl;
-#endif
-
-    return kernel_map[key];
+    static const std::vector<Kernel> empty{};
+    const auto kernels = kernel_map.find(key);
+    return kernels == kernel_map.end() ? empty : kernels->second;
 }
 
 Kernel KernelCache::AddKernel(Handle& h,
-                              const std::string& algorithm,
-                              const std::string& network_config,
+                              const Key& key,
                               const std::string& program_name,
                               const std::string& kernel_name,
                               const std::vector<size_t>& vld,
@@ -121,48 +187,70 @@ Kernel KernelCache::AddKernel(Handle& h,
 {
     if(params.length() > 0)
     {
-        // Ensure only one space after the -cl-std.
-        // >1 space can cause an Apple compiler bug. See clSPARSE issue #141.
-        if(params.at(0) != ' ')
-        {
-            params = " " + params;
-        }
+        params = NormalizeParams(params);
 #ifndef NDEBUG
         dump_kernel_params(program_name, kernel_name, vld, vgd, params);
 #endif
     }
 
-    std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
 #ifndef NDEBUG
-    std::cout << "key: " << key.first << ',' << key.second << std::endl;
+    std::cout << "key: " << key.ToString() << std::endl;
 #endif
 
     Program program;
-
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
+    const auto program_key = std::make_pair(program_name, params);
+    std::shared_future<Program> existing;
+    std::promise<Program> built;
     {
-        program = program_it->second;
+        // Other handles wait for the build instead of building the program too.
+        std::lock_guard<std::mutex> lock(programs->mutex);
+        const auto program_it = programs->programs.find(program_key);
+        if(program_it != programs->programs.end())
+            existing = program_it->second;
+        else
+            programs->programs.emplace(program_key, built.get_future().share());
     }
-    else
+
+    try
     {
-        bool is_kernel_str = algorithm.find("GEMM") != std::string::npos;
+        if(existing.valid())
+        {
+            program = existing.get();
+        }
+        else
+        {
+            const auto& algorithm = key.GetAlgorithm().GetName();
+            bool is_kernel_str    = algorithm.find("GEMM") != std::string::npos;
 #ifndef NDEBUG
-        if(is_kernel_str == false)
-            std::cout << "Kernel filename: " << program_name << "\n";
+            if(is_kernel_str == false)
+                std::cout << "Kernel filename: " << program_name << "\n";
 #endif
-        program = h.LoadProgram(program_name, params, is_kernel_str);
-        program_map[std::make_pair(program_name, params)] = program;
+            try
+            {
+                program = h.LoadProgram(program_name, params, is_kernel_str);
+            }
+            catch(...)
+            {
+                built.set_exception(std::current_exception());
+                throw;
+            }
+            built.set_value(program);
+        }
+    }
+    catch(...)
+    {
+        EraseFailed(*programs, program_key);
+        throw;
     }
     Kernel kernel{program, kernel_name, vld, vgd};
-    if(!network_config.empty() && !algorithm.empty())
+    if(!key.IsEmpty())
     {
         this->AddKernel(key, kernel, cache_index);
     }
     return kernel;
 }
 
-void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
+void KernelCache::AddKernel(const Key& key, Kernel k, std::size_t cache_index)
 {
     auto&& v = kernel_map[key];
     if(cache_index >= v.size())
@@ -172,6 +260,99 @@ void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
     v[cache_index] = k;
 }
 
-KernelCache::KernelCache() {}
+void KernelCache::Precompile(const ProgramLoader& load,
+                             const std::string& program_name,
+                             std::string params,
+                             bool is_kernel_str)
+{
+    params         = NormalizeParams(params);
+    const auto key = std::make_pair(program_name, params);
+    const auto pool = GetCompilePool();
+    std::promise<Program> built;
+    {
+        std::lock_guard<std::mutex> lock(programs->mutex);
+        if(programs->programs.find(key) != programs->programs.end())
+            return;
+
+        if(pool != nullptr)
+        {
+            MIOPEN_LOG_I2("Building in the background: " << program_name << ", " << params);
+            const auto building = pool->Submit([load, program_name, params, is_kernel_str]() {
+                                          return load(program_name, params, is_kernel_str);
+                                      })
+                                      .share();
+            programs->programs.emplace(key, building);
+
+            started.erase(std::remove_if(started.begin(),
+                                         started.end(),
+                                         [](const std::shared_future<Program>& program) {
+                                             return program.wait_for(std::chrono::seconds(0)) ==
+                                                    std::future_status::ready;
+                                         }),
+                          started.end());
+            started.push_back(building);
+        }
+        else
+        {
+            programs->programs.emplace(key, built.get_future().share());
+        }
+    }
+
+    if(pool == nullptr)
+    {
+        try
+        {
+            built.set_value(load(program_name, params, is_kernel_str));
+        }
+        catch(...)
+        {
+            built.set_exception(std::current_exception());
+        }
+    }
+    precompiled.push_back(key);
+}
+
+KernelCache::PrecompileResult KernelCache::WaitForPrecompiled()
+{
+    PrecompileResult result;
+    for(const auto& key : precompiled)
+    {
+        std::shared_future<Program> program;
+        {
+            std::lock_guard<std::mutex> lock(programs->mutex);
+            const auto program_it = programs->programs.find(key);
+            if(program_it == programs->programs.end())
+                continue; // Has failed in AddKernel().
+            program = program_it->second;
+        }
+        try
+        {
+            program.get();
+            ++result.built;
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Failed to build " << key.first << ", " << key.second << ": "
+                                            << ex.what());
+            EraseFailed(*programs, key);
+            ++result.failed;
+        }
+    }
+    precompiled.clear();
+    return result;
+}
+
+KernelCache::KernelCache() : programs(std::make_shared<SharedPrograms>()) {}
+
+KernelCache::~KernelCache()
+{
+    for(const auto& program : started)
+        program.wait();
+}
+
+void KernelCache::SharePrograms(const void* context, const void* device)
+{
+    programs = GetSharedPrograms(context, device);
+}
 
 } // namespace miopen
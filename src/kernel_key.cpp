@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel_key.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace miopen {
+
+struct AlgorithmNames
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, std::size_t> ids;
+    // Deque keeps the references returned by GetName() valid.
+    std::deque<std::string> names;
+};
+
+static AlgorithmNames& GetAlgorithmNames()
+{
+    static AlgorithmNames names;
+    return names;
+}
+
+KernelAlgorithm::KernelAlgorithm(const std::string& name)
+{
+    auto& table = GetAlgorithmNames();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    const auto inserted = table.ids.emplace(name, table.names.size());
+    if(inserted.second)
+        table.names.push_back(name);
+    id = inserted.first->second;
+}
+
+const std::string& KernelAlgorithm::GetName() const
+{
+    auto& table = GetAlgorithmNames();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.names[id];
+}
+
+static constexpr std::size_t chars_per_field = sizeof(KernelKey::Field);
+
+static KernelKey::Field PackChars(const char* chars, std::size_t count)
+{
+    std::uint64_t packed = 0;
+    for(std::size_t i = 0; i < count; ++i)
+        packed |= static_cast<std::uint64_t>(static_cast<unsigned char>(chars[i])) << (8 * i);
+    return static_cast<KernelKey::Field>(packed);
+}
+
+KernelKey::KernelKey(const KernelAlgorithm& algorithm_, std::initializer_list<Field> fields_)
+    : algorithm(algorithm_), fields(fields_), is_string(false)
+{
+    ComputeHash();
+}
+
+KernelKey::KernelKey(const KernelAlgorithm& algorithm_, Fields fields_)
+    : algorithm(algorithm_), fields(std::move(fields_)), is_string(false)
+{
+    ComputeHash();
+}
+
+KernelKey::KernelKey(const KernelAlgorithm& algorithm_, const std::string& network_config)
+    : algorithm(algorithm_), is_string(true)
+{
+    const auto size = network_config.size();
+    fields.reserve(1 + (size + chars_per_field - 1) / chars_per_field);
+    fields.push_back(size);
+    for(std::size_t i = 0; i < size; i += chars_per_field)
+        fields.push_back(
+            PackChars(network_config.data() + i, std::min(chars_per_field, size - i)));
+    ComputeHash();
+}
+
+KernelKey::KernelKey(const std::string& algorithm_, const std::string& network_config)
+    : KernelKey(KernelAlgorithm{algorithm_}, network_config)
+{
+}
+
+bool KernelKey::IsEmpty() const
+{
+    return is_string && (fields.front() == 0 || algorithm.GetName().empty());
+}
+
+KernelKey::Field KernelKey::Pack(const std::string& str)
+{
+    return PackChars(str.data(), std::min(chars_per_field, str.size()));
+}
+
+KernelKey::Field KernelKey::Pack(double value)
+{
+    static_assert(sizeof(value) == sizeof(Field), "");
+    Field packed;
+    std::memcpy(&packed, &value, sizeof(packed));
+    return packed;
+}
+
+void KernelKey::ComputeHash()
+{
+    // Same mixing as boost::hash_combine.
+    const auto combine = [](std::size_t seed, std::size_t value) {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    };
+    hash = combine(algorithm.GetId(), is_string ? 1 : 0);
+    for(const auto field : fields)
+        hash = combine(hash, std::hash<Field>{}(field));
+}
+
+std::string KernelKey::ToString() const
+{
+    auto result = algorithm.GetName() + ", ";
+    if(is_string)
+    {
+        const auto size = static_cast<std::size_t>(fields.front());
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            const auto field = static_cast<std::uint64_t>(fields[1 + i / chars_per_field]);
+            result += static_cast<char>(field >> (8 * (i % chars_per_field)));
+        }
+        return result;
+    }
+    for(auto it = fields.begin(); it != fields.end(); ++it)
+    {
+        if(it != fields.begin())
+            result += "x";
+        result += std::to_string(*it);
+    }
+    return result;
+}
+
+} // namespace miopen
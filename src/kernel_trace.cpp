@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel_trace.hpp>
+#include <miopen/errors.hpp>
+
+#include <cstdio>
+#include <iomanip>
+#include <utility>
+
+namespace miopen {
+
+KernelTrace::KernelTrace(std::size_t capacity, ReadEvent read_event_)
+    : read_event(read_event_), launches(capacity)
+{
+    if(capacity == 0)
+        MIOPEN_THROW(miopenStatusBadParm, "The kernel trace must hold at least one launch");
+}
+
+void KernelTrace::Add(std::string kernel_name, std::string network_config, Event event)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& launch                = launches[next];
+    launch.entry                = KernelTraceEntry{};
+    launch.entry.kernel_name    = std::move(kernel_name);
+    launch.entry.network_config = std::move(network_config);
+    launch.event                = std::move(event);
+
+    next = (next + 1) % launches.size();
+    if(count < launches.size())
+        ++count;
+}
+
+std::vector<KernelTraceEntry> KernelTrace::Get()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<KernelTraceEntry> result;
+    result.reserve(count);
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        auto& launch = launches[(next + launches.size() - count + i) % launches.size()];
+        if(launch.event != nullptr)
+        {
+            read_event(launch.event.get(), launch.entry);
+            launch.event = nullptr;
+        }
+        result.push_back(launch.entry);
+    }
+    return result;
+}
+
+static void WriteJsonString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for(const auto c : str)
+    {
+        if(c == '"' || c == '\\')
+        {
+            os << '\\' << c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            os << escaped;
+        }
+        else
+        {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+void WriteChromeTrace(std::ostream& os, const std::vector<KernelTraceEntry>& entries)
+{
+    // Timestamps of the format are in microseconds.
+    const auto flags = os.flags();
+    os << std::fixed << std::setprecision(3);
+    os << "{\"traceEvents\":[";
+    for(std::size_t i = 0; i < entries.size(); ++i)
+    {
+        const auto& entry = entries[i];
+        os << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+        WriteJsonString(os, entry.kernel_name);
+        os << ",\"cat\":\"kernel\",\"ph\":\"X\",\"pid\":0,\"tid\":0";
+        os << ",\"ts\":" << entry.start / 1000.0;
+        os << ",\"dur\":" << (entry.end >= entry.start ? entry.end - entry.start : 0) / 1000.0;
+        os << ",\"args\":{\"network_config\":";
+        WriteJsonString(os, entry.network_config);
+        os << ",\"queued_us\":" << entry.queued / 1000.0 << "}}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    os.flags(flags);
+}
+
+} // namespace miopen
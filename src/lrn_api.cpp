@@ -26,6 +26,7 @@
 #include <array>
 #include <initializer_list>
 #include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
 #include <miopen/lrn.hpp>
 #include <miopen/logger.hpp>
 
@@ -104,6 +105,28 @@ extern "C" miopenStatus_t miopenLRNForward(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t miopenPrecompileLRNForward(miopenHandle_t handle,
+                                                     const miopenLRNDescriptor_t lrnDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenTensorDescriptor_t yDesc,
+                                                     bool do_backward)
+{
+
+    MIOPEN_LOG_FUNCTION(lrnDesc, xDesc, yDesc, do_backward);
+    return miopen::try_([&] {
+        miopen::AutoPrecompileOnly precompile_only{miopen::deref(handle)};
+        miopen::deref(lrnDesc).Forward(miopen::deref(handle),
+                                       nullptr,
+                                       miopen::deref(xDesc),
+                                       precompile_only.GetBuffer(),
+                                       nullptr,
+                                       miopen::deref(yDesc),
+                                       precompile_only.GetBuffer(),
+                                       do_backward,
+                                       precompile_only.GetBuffer());
+    });
+}
+
 extern "C" miopenStatus_t miopenLRNBackward(miopenHandle_t handle,
                                             const miopenLRNDescriptor_t lrnDesc,
                                             const void* alpha,
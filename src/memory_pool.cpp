@@ -0,0 +1,260 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/memory_pool.hpp>
+#include <miopen/env.hpp>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_MEMORY_POOL)
+
+/// A buffer allocated by a pool, and the context of its deleter.
+struct MemoryPool::Block
+{
+    State* state;
+    void* buffer;
+    std::size_t size;
+    /// Frees the buffer with the allocator it comes from.
+    AllocatorDeleter deleter;
+};
+
+struct MemoryPool::State
+{
+    mutable std::mutex mutex;
+    Allocator allocator{};
+    std::size_t capacity = 0;
+    std::map<std::size_t, std::vector<Block*>> cached;
+    MemoryPoolStats stats;
+    /// Buffers in use, the state is deleted once they are all released after the pool.
+    std::size_t outstanding = 0;
+    bool closed             = false;
+
+    std::vector<Block*> TakeCached()
+    {
+        std::vector<Block*> result;
+        for(auto&& p : cached)
+            result.insert(result.end(), p.second.begin(), p.second.end());
+        cached.clear();
+        stats.cached = 0;
+        return result;
+    }
+
+    Allocator::ManageDataPtr HandOut(Block* block)
+    {
+        stats.in_use += block->size;
+        stats.peak = std::max(stats.peak, stats.in_use + stats.cached);
+        ++outstanding;
+        return Allocator::ManageDataPtr{DataCast(block->buffer), AllocatorDeleter{&Release, block}};
+    }
+
+    static void Free(const std::vector<Block*>& blocks)
+    {
+        for(auto* block : blocks)
+        {
+            block->deleter(block->buffer);
+            delete block;
+        }
+    }
+};
+
+MemoryPool::MemoryPool() : state(new State{}) {}
+
+MemoryPool::~MemoryPool()
+{
+    this->Trim();
+    bool last = false;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->closed = true;
+        last          = state->outstanding == 0;
+    }
+    if(last)
+        delete state;
+}
+
+void MemoryPool::SetAllocator(const Allocator& allocator)
+{
+    std::vector<Block*> blocks;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->allocator = allocator;
+        blocks           = state->TakeCached();
+    }
+    State::Free(blocks);
+}
+
+void MemoryPool::SetCapacity(std::size_t capacity)
+{
+    std::vector<Block*> blocks;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->capacity = capacity;
+        if(state->stats.cached > capacity)
+            blocks = state->TakeCached();
+    }
+    State::Free(blocks);
+}
+
+std::size_t MemoryPool::GetCapacity() const
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->capacity;
+}
+
+Allocator::ManageDataPtr MemoryPool::Reuse(std::size_t n)
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if(n == 0 || state->capacity == 0)
+        return nullptr;
+    auto it = state->cached.find(GetSizeClass(n));
+    if(it == state->cached.end() || it->second.empty())
+        return nullptr;
+
+    // The last buffer released is the likeliest to still be in the caches of the device.
+    auto* block = it->second.back();
+    it->second.pop_back();
+    state->stats.cached -= block->size;
+    ++state->stats.hits;
+    return state->HandOut(block);
+}
+
+Allocator::ManageDataPtr MemoryPool::Allocate(std::size_t n)
+{
+    Allocator allocator;
+    std::size_t size = n;
+    bool has_cached  = false;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        allocator = state->allocator;
+        if(state->capacity != 0)
+            size = GetSizeClass(n);
+        has_cached = state->stats.cached != 0;
+    }
+    assert(allocator.allocator != nullptr);
+    assert(allocator.deallocator != nullptr);
+
+    void* buffer = nullptr;
+    try
+    {
+        buffer = allocator.allocator(allocator.context, size);
+    }
+    catch(...)
+    {
+        if(!has_cached)
+            throw;
+    }
+    if(buffer == nullptr && size != 0 && has_cached)
+    {
+        this->Trim();
+        buffer = allocator.allocator(allocator.context, size);
+    }
+    if(buffer == nullptr)
+    {
+        if(size != 0)
+        {
+            MIOPEN_THROW("Failed to allocate memory for buffer size " + std::to_string(size));
+        }
+        return nullptr;
+    }
+
+    auto* block =
+        new Block{state, buffer, size, AllocatorDeleter{allocator.deallocator, allocator.context}};
+    std::lock_guard<std::mutex> lock(state->mutex);
+    ++state->stats.misses;
+    return state->HandOut(block);
+}
+
+void MemoryPool::Trim()
+{
+    std::vector<Block*> blocks;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        blocks = state->TakeCached();
+    }
+    State::Free(blocks);
+}
+
+MemoryPoolStats MemoryPool::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->stats;
+}
+
+std::size_t MemoryPool::GetSizeClass(std::size_t n)
+{
+    const std::size_t min_size = 256;
+    if(n <= min_size)
+        return min_size;
+    // Rounds up to a quarter of the highest power of two not above n, which wastes at most a
+    // fifth of the buffer.
+    std::size_t power = min_size;
+    while(power <= n / 2)
+        power *= 2;
+    const auto step = power / 4;
+    return (n + step - 1) / step * step;
+}
+
+std::size_t MemoryPool::GetDefaultCapacity(std::size_t device_memory)
+{
+    return miopen::IsDisabled(MIOPEN_DEBUG_MEMORY_POOL{}) ? 0 : device_memory / 4;
+}
+
+void MemoryPool::Release(void* context, void* buffer)
+{
+    auto* block = static_cast<Block*>(context);
+    auto* pool  = block->state;
+    bool cache  = false;
+    bool last   = false;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->stats.in_use -= block->size;
+        --pool->outstanding;
+        // Buffers of a previous allocator are not reused.
+        cache = !pool->closed && pool->capacity != 0 &&
+                block->deleter.deallocator == pool->allocator.deallocator &&
+                block->deleter.context == pool->allocator.context &&
+                pool->stats.cached + block->size <= pool->capacity;
+        if(cache)
+        {
+            assert(block->buffer == buffer);
+            pool->cached[block->size].push_back(block);
+            pool->stats.cached += block->size;
+        }
+        last = pool->closed && pool->outstanding == 0;
+    }
+    // The deallocator may release other buffers of the pool.
+    if(!cache)
+        State::Free({block});
+    if(last)
+        delete pool;
+}
+
+} // namespace miopen
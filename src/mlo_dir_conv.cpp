@@ -31,16 +31,19 @@
 #include <cmath>
 #include <cstring>
 #include <iomanip>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <unordered_map>
 
 #include <miopen/solver.hpp>
 #include <miopen/db.hpp>
+#include <miopen/each_args.hpp>
 #include <miopen/env.hpp>
 #include <miopen/gcn_asm_utils.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/mlo_utils.hpp>
+#include <miopen/rank.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GCN_ASM_KERNELS)
 
@@ -50,7 +53,96 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GCN_ASM_KERNELS)
  **
  ************************************************************************************************************************/
 
-miopen::Db mlo_construct_direct2D::GetDb() const { return {db_path()}; }
+miopen::MultiFileDb& mlo_construct_direct2D::GetDb() const
+{
+    // Explicitly set db is used as is (the user db is not involved).
+    if(_db_path != nullptr)
+        return miopen::MultiFileDb::Get(_db_path, "");
+    return _search_params.GetPerfDb();
+}
+
+namespace {
+
+template <class Solver>
+auto MakePerfDbValidator(miopen::rank<1>, Solver s)
+    -> decltype(s.Search(std::declval<const miopen::ConvolutionContext&>()),
+                miopen::solver::PerfDbValidator{})
+{
+    return [s](const miopen::ConvolutionContext& problem, const std::string& values) {
+        using PerformanceConfig = decltype(s.GetPerformanceConfig(problem));
+        PerformanceConfig config{};
+        return config.Deserialize(values) && s.IsValidPerformanceConfig(problem, config);
+    };
+}
+
+template <class Solver>
+miopen::solver::PerfDbValidator MakePerfDbValidator(miopen::rank<0>, Solver)
+{
+    return nullptr;
+}
+
+/// Solvers tried by one of the mlo_construct_* classes, in order of preference.
+template <class... Solvers>
+struct SolverList
+{
+    template <class Context>
+    static miopen::solver::ConvSolution Search(const Context& context, miopen::MultiFileDb& db)
+    {
+        return miopen::solver::SearchForSolution<Solvers...>(context, db);
+    }
+
+    static void
+    AddPerfDbValidators(std::map<std::string, miopen::solver::PerfDbValidator>& validators)
+    {
+        MIOPEN_STATIC_FOR_EACH(solver, Solvers{}, {
+            validators[miopen::solver::SolverDbId(solver)] =
+                MakePerfDbValidator(miopen::rank<1>{}, solver);
+        });
+    }
+};
+
+// clang-format off
+using DirectSolvers = SolverList<
+    miopen::solver::ConvAsm3x3U,
+    miopen::solver::ConvAsm1x1U,
+    miopen::solver::ConvAsm5x10u2v2f1,
+    miopen::solver::ConvAsm7x7c3h224w224k64u2v2p3q3f1,
+    miopen::solver::ConvAsm5x10u2v2b1,
+    miopen::solver::ConvOclDirectFwd11x11,
+    miopen::solver::ConvOclDirectFwdGen,
+    miopen::solver::ConvOclDirectFwd3x3,
+    miopen::solver::ConvOclDirectFwd1x1,
+    miopen::solver::ConvOclDirectFwd
+>;
+
+using WinogradSolvers = SolverList<
+    miopen::solver::ConvBinWinograd3x3U,
+    miopen::solver::ConvBinWinogradRxS
+>;
+
+using BwdWrW2DSolvers = SolverList<
+    miopen::solver::ConvAsmBwdWrW1x1,
+    miopen::solver::ConvAsmBwdWrW3x3,
+    miopen::solver::ConvOclBwdWrW2,
+    miopen::solver::ConvOclBwdWrW53,
+    miopen::solver::ConvOclBwdWrW1x1
+>;
+// clang-format on
+
+} // namespace
+
+const std::map<std::string, miopen::solver::PerfDbValidator>&
+miopen::solver::GetPerfDbValidators()
+{
+    static const auto validators = [] {
+        std::map<std::string, PerfDbValidator> result;
+        DirectSolvers::AddPerfDbValidators(result);
+        WinogradSolvers::AddPerfDbValidators(result);
+        BwdWrW2DSolvers::AddPerfDbValidators(result);
+        return result;
+    }();
+    return validators;
+}
 
 /*
    construction has been split into 2
@@ -59,43 +151,17 @@ miopen::Db mlo_construct_direct2D::GetDb() const { return {db_path()}; }
    */
 miopen::solver::ConvSolution mlo_construct_direct2D::FindSolution()
 {
-    // clang-format off
-    return miopen::solver::SearchForSolution<
-        miopen::solver::ConvAsm3x3U,
-        miopen::solver::ConvAsm1x1U,
-        miopen::solver::ConvAsm5x10u2v2f1,
-        miopen::solver::ConvAsm7x7c3h224w224k64u2v2p3q3f1,
-        miopen::solver::ConvAsm5x10u2v2b1,
-        miopen::solver::ConvOclDirectFwd11x11,
-        miopen::solver::ConvOclDirectFwdGen,
-        miopen::solver::ConvOclDirectFwd3x3,
-        miopen::solver::ConvOclDirectFwd1x1,
-        miopen::solver::ConvOclDirectFwd
-    >(_search_params, this->GetDb());
-    // clang-format on
+    return DirectSolvers::Search(_search_params, this->GetDb());
 }
 
 miopen::solver::ConvSolution mlo_construct_winograd::FindSolution()
 {
-    // clang-format off
-    return miopen::solver::SearchForSolution<
-        miopen::solver::ConvBinWinograd3x3U,
-        miopen::solver::ConvBinWinogradRxS
-    >(_search_params, this->GetDb());
-    // clang-format on
+    return WinogradSolvers::Search(_search_params, this->GetDb());
 }
 
 miopen::solver::ConvSolution mlo_construct_BwdWrW2D::FindSolution()
 {
-    // clang-format off
-    return miopen::solver::SearchForSolution<
-        miopen::solver::ConvAsmBwdWrW1x1,
-        miopen::solver::ConvAsmBwdWrW3x3,
-        miopen::solver::ConvOclBwdWrW2,
-        miopen::solver::ConvOclBwdWrW53,
-        miopen::solver::ConvOclBwdWrW1x1
-    >(_search_params, this->GetDb());
-    // clang-format on
+    return BwdWrW2DSolvers::Search(_search_params, this->GetDb());
 }
 
 void mlo_construct_direct2D::mloUseSolution(const miopen::solver::ConvSolution& s)
@@ -322,24 +388,23 @@ n of input blocks
 n batchs (stacks) processed by the group
 */
 
-int mlo_construct_direct2D::mloBuildConf_Key(std::string& conf_key) const
+miopen::KernelKey
+mlo_construct_direct2D::mloBuildConf_Key(const miopen::KernelAlgorithm& algorithm) const
 {
-
-    conf_key =
-        std::to_string(static_cast<long long>(_search_params.n_inputs)) + std::string("x") +
-        std::to_string(static_cast<long long>(_search_params.in_height)) + std::string("x") +
-        std::to_string(static_cast<long long>(_search_params.in_width)) + std::string("x") +
-        std::to_string(static_cast<long long>(_search_params.kernel_size1)) + std::string("x") +
-        std::to_string(static_cast<long long>(_search_params.kernel_size0)) + std::string("x") +
-        std::to_string(static_cast<long long>(_search_params.n_outputs)) + std::string("x") +
-        std::to_string(static_cast<long long>(_search_params.out_height)) + std::string("x") +
-        std::to_string(static_cast<long long>(_search_params.out_width)) + std::string("x") +
-        std::to_string(static_cast<long long>(_search_params.batch_sz)) + std::string("x") +
-        _search_params.in_layout + std::string("x") + _search_params.in_data_type +
-        std::string("x") + (_search_params.direction.IsForward()
-                                ? "1"
-                                : "0"); /// \todo Shall we separate keys for WrW convolutions?
-    return (0);
+    /// \todo Shall we separate keys for WrW convolutions?
+    return {algorithm,
+            {_search_params.n_inputs,
+             _search_params.in_height,
+             _search_params.in_width,
+             _search_params.kernel_size1,
+             _search_params.kernel_size0,
+             _search_params.n_outputs,
+             _search_params.out_height,
+             _search_params.out_width,
+             _search_params.batch_sz,
+             miopen::KernelKey::Pack(_search_params.in_layout),
+             miopen::KernelKey::Pack(_search_params.in_data_type),
+             _search_params.direction.IsForward() ? 1 : 0}};
 }
 
 // Tensor Helper APIs
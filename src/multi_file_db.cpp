@@ -0,0 +1,276 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/multi_file_db.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <limits>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace miopen {
+
+static std::string GetBinaryDbPath(const std::string& text_path)
+{
+    const std::string text_ext = ".txt";
+
+    if(text_path.size() < text_ext.size() ||
+       text_path.compare(text_path.size() - text_ext.size(), text_ext.size(), text_ext) != 0)
+        return {};
+    return text_path.substr(0, text_path.size() - text_ext.size()) + ".bin";
+}
+
+MultiFileDb::MultiFileDb(const std::string& installed_path, const std::string& user_path)
+    : user(user_path.empty() ? installed_path : user_path),
+      user_file(user_path.empty() ? installed_path : user_path)
+{
+    GetFileStamp(user_file, cache_stamp);
+
+    if(user_path.empty())
+        return;
+
+    const auto binary_path = GetBinaryDbPath(installed_path);
+    if(!binary_path.empty())
+    {
+        const BinaryDb binary(binary_path);
+        if(binary.IsAvailable())
+            installed_binary.emplace(binary);
+    }
+    if(!installed_binary)
+        installed_text.emplace(installed_path);
+
+    const auto user_dir = boost::filesystem::path(user_path).parent_path();
+    boost::system::error_code error;
+    if(!user_dir.empty() && !boost::filesystem::exists(user_dir, error))
+    {
+        boost::filesystem::create_directories(user_dir, error);
+        if(error)
+            MIOPEN_LOG_W("Unable to create user db directory " << user_dir.string() << ": "
+                                                               << error.message());
+    }
+}
+
+MultiFileDb& MultiFileDb::Get(const std::string& installed_path, const std::string& user_path)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<std::string, std::string>, MultiFileDb> dbs;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto emplaced = dbs.emplace(std::piecewise_construct,
+                                      std::forward_as_tuple(installed_path, user_path),
+                                      std::forward_as_tuple(installed_path, user_path));
+    return emplaced.first->second;
+}
+
+boost::optional<DbRecord> MultiFileDb::FindRecord(const std::string& key)
+{
+    std::size_t invalidations_before;
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        RevalidateCacheUnsafe(false);
+        const auto cached = cache.find(key);
+        if(cached != cache.end())
+            return cached->second;
+        // The files are read anyway.
+        RevalidateCacheUnsafe(true);
+        invalidations_before = invalidations;
+    }
+
+    boost::optional<DbRecord> record;
+
+    {
+        std::lock_guard<std::mutex> lock(db_mutex);
+        record = user.FindRecord(key);
+
+        boost::optional<DbRecord> installed_record;
+        if(installed_binary)
+            installed_record = installed_binary->FindRecord(key);
+        else if(installed_text)
+            installed_record = installed_text->FindRecord(key);
+
+        if(!record)
+            record = std::move(installed_record);
+        else if(installed_record)
+            record->Merge(*installed_record);
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    // A change in between may have made the record outdated.
+    if(invalidations == invalidations_before)
+        cache.emplace(key, record);
+    return record;
+}
+
+boost::optional<DbRecord> MultiFileDb::FindClosestRecord(const std::string& id,
+                                                         const DbKeyDistance& distance)
+{
+    boost::optional<DbRecord> closest;
+
+    {
+        std::lock_guard<std::mutex> lock(db_mutex);
+        closest = user.FindClosestRecord(id, distance);
+
+        boost::optional<DbRecord> installed_closest;
+        if(installed_binary)
+            installed_closest = installed_binary->FindClosestRecord(id, distance);
+        else if(installed_text)
+            installed_closest = installed_text->FindClosestRecord(id, distance);
+
+        if(installed_closest &&
+           (!closest || distance(installed_closest->key) < distance(closest->key)))
+            closest = std::move(installed_closest);
+    }
+
+    if(!closest)
+        return boost::none;
+    return FindRecord(closest->key);
+}
+
+boost::optional<DbRecord> MultiFileDb::FindClosestRecord(const std::string& key,
+                                                         const std::string& id,
+                                                         const DbKeyDistance& distance)
+{
+    const auto cache_key = std::make_pair(key, id);
+    boost::optional<std::string> closest_key;
+    std::size_t invalidations_before;
+    bool cached_closest;
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        RevalidateCacheUnsafe(false);
+        const auto cached = closest_cache.find(cache_key);
+        cached_closest    = cached != closest_cache.end();
+        if(cached_closest)
+            closest_key = cached->second;
+        else
+            RevalidateCacheUnsafe(true);
+        invalidations_before = invalidations;
+    }
+
+    if(cached_closest)
+        return closest_key ? FindRecord(*closest_key) : boost::none;
+
+    const auto closest = FindClosestRecord(id, [&](const std::string& other) {
+        return other == key ? std::numeric_limits<double>::infinity() : distance(other);
+    });
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    // A change in between may have made another record closer.
+    if(invalidations == invalidations_before)
+        closest_cache.emplace(cache_key,
+                              closest ? boost::optional<std::string>(closest->key) : boost::none);
+    return closest;
+}
+
+bool MultiFileDb::StoreRecord(const DbRecord& record)
+{
+    bool ok;
+    {
+        std::lock_guard<std::mutex> lock(db_mutex);
+        ok = user.StoreRecord(record);
+    }
+    Invalidate(record.key);
+    return ok;
+}
+
+bool MultiFileDb::UpdateRecord(DbRecord& record)
+{
+    bool ok;
+    {
+        std::lock_guard<std::mutex> lock(db_mutex);
+        ok = user.UpdateRecord(record);
+    }
+    Invalidate(record.key);
+    return ok;
+}
+
+bool MultiFileDb::RemoveRecord(const std::string& key)
+{
+    bool ok;
+    {
+        std::lock_guard<std::mutex> lock(db_mutex);
+        ok = user.RemoveRecord(key);
+    }
+    Invalidate(key);
+    return ok;
+}
+
+bool MultiFileDb::Remove(const std::string& key, const std::string& id)
+{
+    bool ok;
+    {
+        std::lock_guard<std::mutex> lock(db_mutex);
+        ok = user.Remove(key, id);
+    }
+    Invalidate(key);
+    return ok;
+}
+
+void MultiFileDb::Invalidate(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache.erase(key);
+    // The changed record may now be the closest one to any key.
+    closest_cache.clear();
+    ++invalidations;
+}
+
+void MultiFileDb::Reload()
+{
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache.clear();
+    closest_cache.clear();
+    ++invalidations;
+}
+
+void MultiFileDb::RevalidateCacheUnsafe(bool force)
+{
+    // Lookups which hit the cache touch the file system at most once per this interval.
+    const auto check_interval = std::chrono::seconds(1);
+    const auto now            = std::chrono::steady_clock::now();
+
+    if(!force && now - cache_checked < check_interval)
+        return;
+    cache_checked = now;
+
+    FileStamp stamp;
+    GetFileStamp(user_file, stamp);
+    if(stamp == cache_stamp)
+        return;
+
+    // The user db has been changed, maybe by another process: any cached record may be stale.
+    cache.clear();
+    closest_cache.clear();
+    cache_stamp = stamp;
+    ++invalidations;
+}
+
+} // namespace miopen
@@ -25,7 +25,7 @@
  *******************************************************************************/
 #include <miopen/config.h>
 #include <miopen/convolution.hpp>
-#include <miopen/db.hpp>
+#include <miopen/multi_file_db.hpp>
 #include <miopen/env.hpp>
 #include <miopen/util.hpp>
 #include <miopen/solver.hpp>
@@ -41,6 +41,15 @@ namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT)
 
+// Interned once, the kernel lookups of the Run paths only compare their ids.
+static const KernelAlgorithm fwd_direct{"miopenConvolutionFwdAlgoDirect"};
+static const KernelAlgorithm fwd_direct_pass2{"miopenConvolutionFwdAlgoDirect_pass2"};
+static const KernelAlgorithm fwd_winograd{"miopenConvolutionFwdAlgoWinograd"};
+static const KernelAlgorithm bwd_data_direct{"miopenConvolutionBwdDataAlgoDirect"};
+static const KernelAlgorithm bwd_data_direct_pass2{"miopenConvolutionBwdDataAlgoDirect_pass2"};
+static const KernelAlgorithm bwd_data_winograd{"miopenConvolutionBwdDataAlgoWinograd"};
+static const KernelAlgorithm bwd_weights_direct{"miopenConvolutionBwdWeightsAlgoDirect_Main"};
+
 struct AutoEnableProfiling
 {
     AutoEnableProfiling(Handle& x) : h(x)
@@ -60,6 +69,12 @@ struct AutoEnableProfiling
     bool prev_state;
 };
 
+static void PrecompileKernels(Handle& handle, const std::vector<mlo_kernel_info>& kernels)
+{
+    for(const auto& k : kernels)
+        handle.PrecompileProgram(std::get<1>(k), std::get<2>(k)); // _kernel_file, _comp_options
+}
+
 int ConvolutionDescriptor::FindWinogradKernel(Handle& handle,
                                               const TensorDescriptor& xDesc,
                                               const TensorDescriptor& wDesc,
@@ -84,16 +99,13 @@ int ConvolutionDescriptor::FindWinogradKernel(Handle& handle,
         std::string kernel_name  = construct_params.getKernelName();
         std::string parms        = construct_params.getCompilerOptions();
 
-        std::string network_config;
-        construct_params.mloBuildConf_Key(network_config);
+        const auto key =
+            construct_params.mloBuildConf_Key(direction == 1 ? fwd_winograd : bwd_data_winograd);
 
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
         const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
-        std::string algorithm = (direction == 1) ? "miopenConvolutionFwdAlgoWinograd"
-                                                 : "miopenConvolutionBwdDataAlgoWinograd";
-        kernel =
-            handle.AddKernel(algorithm, network_config, program_name, kernel_name, vld, vgd, parms);
+        kernel = handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms);
 
         int N, C, H, W, K, n_groups, out_H, out_W, R, S, pad_H, pad_W;
         construct_params.getCompiledInParameters(
@@ -160,26 +172,24 @@ int ConvolutionDescriptor::FindDirectKernel(Handle& handle,
         std::string kernel_name  = construct_params.getKernelName();
         const std::string& parms = construct_params.getCompilerOptions();
 
-        std::string network_config;
-        construct_params.mloBuildConf_Key(network_config);
+        const auto key =
+            construct_params.mloBuildConf_Key(direction == 1 ? fwd_direct : bwd_data_direct);
 
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
         const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
-        std::string algorithm = (direction == 1) ? "miopenConvolutionFwdAlgoDirect"
-                                                 : "miopenConvolutionBwdDataAlgoDirect";
-
         {
             int N, C, H, W, K, n_groups;
             construct_params.getCompiledInParameters(&N, &C, &H, &W, &K, &n_groups);
             extraArgs = std::make_tuple(N, C, H, W, K, n_groups);
         }
+        PrecompileKernels(handle, construct_params.getKernelsInfo());
+
         // if not 11x11
         if(program_name != "MIOpenConvFwd_LxL_11.cl")
         {
 
-            auto k = handle.AddKernel(
-                algorithm, network_config, program_name, kernel_name, vld, vgd, parms);
+            auto k = handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms);
 
             kernels.push_back(k);
         }
@@ -199,8 +209,7 @@ int ConvolutionDescriptor::FindDirectKernel(Handle& handle,
             {
                 const mlo_kernel_info& bwd_wrw = bwd_wrw_info[0];
 
-                auto k1 = handle.AddKernel(algorithm,
-                                           network_config,
+                auto k1 = handle.AddKernel(key,
                                            std::get<1>(bwd_wrw),
                                            std::get<0>(bwd_wrw),
                                            std::get<4>(bwd_wrw),
@@ -213,8 +222,7 @@ int ConvolutionDescriptor::FindDirectKernel(Handle& handle,
             {
                 auto bwd_wrw_main = bwd_wrw_info[0];
 
-                auto k1 = handle.AddKernel(algorithm,
-                                           network_config,
+                auto k1 = handle.AddKernel(key,
                                            std::get<1>(bwd_wrw_main),
                                            std::get<0>(bwd_wrw_main),
                                            std::get<4>(bwd_wrw_main),
@@ -224,12 +232,12 @@ int ConvolutionDescriptor::FindDirectKernel(Handle& handle,
                 kernels.push_back(k1);
 
                 // second kernel hash
-                network_config += "x1";
+                const auto key2 = construct_params.mloBuildConf_Key(
+                    direction == 1 ? fwd_direct_pass2 : bwd_data_direct_pass2);
                 // second pass  kernel
                 auto bwd_wrw_red = bwd_wrw_info[1];
 
-                auto k2 = handle.AddKernel(algorithm + "_pass2",
-                                           network_config,
+                auto k2 = handle.AddKernel(key2,
                                            std::get<1>(bwd_wrw_red),
                                            std::get<0>(bwd_wrw_red),
                                            std::get<4>(bwd_wrw_red),
@@ -248,6 +256,69 @@ int ConvolutionDescriptor::FindDirectKernel(Handle& handle,
     }
 }
 
+/// Starts building the kernels of the winograd and direct solutions in the background,
+/// so that FindWinogradKernel() and FindDirectKernel() do not compile them one by one.
+void ConvolutionDescriptor::PrecompileDirectKernels(Handle& handle,
+                                                    const TensorDescriptor& xDesc,
+                                                    const TensorDescriptor& wDesc,
+                                                    const TensorDescriptor& yDesc,
+                                                    bool exhaustiveSearch,
+                                                    int direction) const
+{
+    try
+    {
+        mlo_construct_winograd construct_params(direction);
+        construct_params.setStream(&handle);
+        construct_params.setOutputDescFromMLDesc(yDesc);
+        construct_params.setInputDescFromMLDesc(xDesc);
+        construct_params.setWeightDescFromMLDesc(wDesc);
+        construct_params.setConvDescr(pad_h, pad_w, u, v, dilation_h, dilation_w);
+        mloConstruct(construct_params);
+        PrecompileKernels(handle, construct_params.getKernelsInfo());
+    }
+    catch(miopen::Exception&)
+    {
+    }
+
+    // Exhaustive search benchmarks the kernels, which must not be done twice.
+    if(exhaustiveSearch || !IsDirectSupported(wDesc) ||
+       miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{}))
+        return;
+
+    mlo_construct_direct2D construct_params(direction);
+    construct_params.doSearch(false);
+    construct_params.setGeneralCompOptions("");
+    construct_params.setStream(&handle);
+    construct_params.setOutputDescFromMLDesc(yDesc);
+    construct_params.setInputDescFromMLDesc(xDesc);
+    construct_params.setWeightDescFromMLDesc(wDesc);
+    construct_params.setConvDescr(pad_h, pad_w, u, v, dilation_h, dilation_w);
+
+    if(IsWinograd3x3Supported(handle, direction, wDesc, (direction ? xDesc : yDesc)) &&
+       construct_params.mloIsFastBinaryWinograd3x3U())
+        return;
+
+    try
+    {
+        mloConstruct(construct_params);
+        PrecompileKernels(handle, construct_params.getKernelsInfo());
+    }
+    catch(miopen::Exception&)
+    {
+    }
+}
+
+/// Builds the kernels FindConvFwdAlgorithm() would try, without the exhaustive search.
+/// GEMM and FFT kernels are not built.
+void ConvolutionDescriptor::PrecompileForward(Handle& handle,
+                                              const TensorDescriptor& xDesc,
+                                              const TensorDescriptor& wDesc,
+                                              const TensorDescriptor& yDesc) const
+{
+    if(mode == miopenConvolution && dilation_h == 1 && dilation_w == 1)
+        PrecompileDirectKernels(handle, xDesc, wDesc, yDesc, false, 1);
+}
+
 void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                                  const TensorDescriptor& xDesc,
                                                  ConstData_t x,
@@ -456,6 +527,8 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
 #endif
         if(dilation_h == 1 && dilation_w == 1)
         {
+            PrecompileDirectKernels(handle, xDesc, wDesc, yDesc, exhaustiveSearch, 1);
+
             // Winograd algo
             WinogradKernelParams k_p;
             KernelInvoke kernel_wino;
@@ -660,12 +733,8 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
             construct_params.setConvDescr(pad_h, pad_w, u, v, dilation_h, dilation_w);
             construct_params.setStream(&handle);
 
-            std::string network_config;
-            construct_params.mloBuildConf_Key(network_config);
-
-            std::string algorithm_name = "miopenConvolutionFwdAlgoDirect";
-            float padding_val          = 0;
-            auto kernel                = handle.GetKernel(algorithm_name, network_config);
+            float padding_val = 0;
+            auto kernel       = handle.GetKernel(construct_params.mloBuildConf_Key(fwd_direct));
 
             visit_float(xDesc.GetType(), [&](auto as_float) {
                 // if not 11x11
@@ -691,9 +760,8 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                     construct_params.mloCopyTo(context);
                     context.n_passes = true;
 
-                    Db db(context.GetPerfDbPath());
-                    solver::ConvSolution solution =
-                        FindSolution(solver::ConvOclDirectFwd11x11{}, context, db);
+                    solver::ConvSolution solution = FindSolution(
+                        solver::ConvOclDirectFwd11x11{}, context, context.GetPerfDb());
 
                     if(solution.passes == 1)
                     {
@@ -702,8 +770,8 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                     else
                     {
                         // second kernel has
-                        network_config += "x1";
-                        auto kernel2 = handle.GetKernel(algorithm_name + "_pass2", network_config);
+                        auto kernel2 =
+                            handle.GetKernel(construct_params.mloBuildConf_Key(fwd_direct_pass2));
 
                         handle.ResetKernelTime();
                         kernel(x, w, y, as_float(padding_val));
@@ -728,11 +796,7 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
 
             construct_params.setStream(&handle);
 
-            std::string network_config;
-            construct_params.mloBuildConf_Key(network_config);
-
-            std::string algorithm_name = "miopenConvolutionFwdAlgoWinograd";
-            auto kernel                = handle.GetKernel(algorithm_name, network_config);
+            auto kernel = handle.GetKernel(construct_params.mloBuildConf_Key(fwd_winograd));
 
             int flags        = 0;
             int reserved     = 0;
@@ -1136,6 +1200,8 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
     {
         if(dilation_h == 1 && dilation_w == 1)
         {
+            PrecompileDirectKernels(handle, dxDesc, wDesc, dyDesc, exhaustiveSearch, 0);
+
             // Winograd algo
             WinogradKernelParams k_p;
             KernelInvoke kernel_wino;
@@ -1476,9 +1542,7 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
                 construct_params.setStream(&handle);
             }
 
-            std::string network_config;
-            construct_params.mloBuildConf_Key(network_config);
-            auto kernel = handle.GetKernel("miopenConvolutionBwdDataAlgoDirect", network_config);
+            auto kernel = handle.GetKernel(construct_params.mloBuildConf_Key(bwd_data_direct));
 
             visit_float(dyDesc.GetType(), [&](auto as_float) {
                 if(kernel.GetName() == "gcnAsmConv1x1U")
@@ -1507,10 +1571,7 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
             construct_params.setConvDescr(pad_h, pad_w, u, v, dilation_h, dilation_w);
 
             construct_params.setStream(&handle);
-            std::string network_config;
-            construct_params.mloBuildConf_Key(network_config);
-
-            auto kernel = handle.GetKernel("miopenConvolutionBwdDataAlgoWinograd", network_config);
+            auto kernel = handle.GetKernel(construct_params.mloBuildConf_Key(bwd_data_winograd));
             /// \todo Copied from ConvolutionDescriptor::FindConvBwdDataAlgorithm()
             static const int F_REVERSE_R = 1 << 0;
             static const int F_REVERSE_S = 1 << 1;
@@ -1992,7 +2053,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 
                 if(try_([&] { mloConstruct(construct_params); }, false) == miopenStatusSuccess)
                 {
-                    construct_params.mloBuildConf_Key(network_config);
+                    PrecompileKernels(handle, construct_params.getKernelsInfo());
+                    const auto key = construct_params.mloBuildConf_Key(bwd_weights_direct);
 
                     visit_float(dyDesc.GetType(), [&](auto as_float) {
 
@@ -2012,8 +2074,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                         {
                             const mlo_kernel_info& bwd_wrw = bwd_wrw_info[0];
                             auto kernel =
-                                handle.AddKernel("miopenConvolutionBwdWeightsAlgoDirect_Main",
-                                                 network_config,
+                                handle.AddKernel(key,
                                                  std::get<1>(bwd_wrw),  // _kernel_file
                                                  std::get<0>(bwd_wrw),  // _kernel_name
                                                  std::get<4>(bwd_wrw),  // _l_wk
@@ -2067,7 +2128,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                                     // subsampling
                                     float time_sub = 0;
                                     time_sub       = SubSampleGPU(
-                                        handle, bwd_wrw_sub, network_config, x, workSpace);
+                                        handle, bwd_wrw_sub, key, x, workSpace);
                                     time_direct += time_sub;
 
                                     // second kernel: wrw  kernel
@@ -2076,8 +2137,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                                     if((std::get<0>(bwd_wrw_main) == "gcnAsmConv1x1WrW"))
                                     {
                                         auto kernel = handle.AddKernel(
-                                            "miopenConvolutionBwdWeightsAlgoDirect_Main",
-                                            network_config,
+                                            key,
                                             std::get<1>(bwd_wrw_main), // _kernel_file
                                             std::get<0>(bwd_wrw_main), // _kernel_name
                                             std::get<4>(bwd_wrw_main), // _l_wk
@@ -2108,8 +2168,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                                         float padding_val = 0;
 
                                         handle.AddKernel(
-                                            "miopenConvolutionBwdWeightsAlgoDirect_Main",
-                                            network_config,
+                                            key,
                                             std::get<1>(bwd_wrw_main),
                                             std::get<0>(bwd_wrw_main),
                                             std::get<4>(bwd_wrw_main),
@@ -2125,8 +2184,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 
                                     float padding_val = 0;
 
-                                    handle.AddKernel("miopenConvolutionBwdWeightsAlgoDirect_Main",
-                                                     network_config,
+                                    handle.AddKernel(key,
                                                      std::get<1>(bwd_wrw_main),
                                                      std::get<0>(bwd_wrw_main),
                                                      std::get<4>(bwd_wrw_main),
@@ -2139,8 +2197,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                                     // second kernel: reduction  kernel
                                     auto bwd_wrw_red = bwd_wrw_info[1];
 
-                                    handle.AddKernel("miopenConvolutionBwdWeightsAlgoDirect_Main",
-                                                     network_config,
+                                    handle.AddKernel(key,
                                                      std::get<1>(bwd_wrw_red),
                                                      std::get<0>(bwd_wrw_red),
                                                      std::get<4>(bwd_wrw_red),
@@ -2341,11 +2398,8 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
 
                 visit_float(dyDesc.GetType(), [&](auto as_float) {
 
-                    std::string network_config;
-                    construct_params.mloBuildConf_Key(network_config);
-
-                    auto&& kernels = handle.GetKernels("miopenConvolutionBwdWeightsAlgoDirect_Main",
-                                                       network_config);
+                    auto&& kernels =
+                        handle.GetKernels(construct_params.mloBuildConf_Key(bwd_weights_direct));
                     const auto num_kernels = kernels.size();
                     auto p_kernel          = std::begin(kernels);
                     auto kernel            = *p_kernel;
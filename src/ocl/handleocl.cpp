@@ -30,10 +30,15 @@
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
 #include <miopen/binary_cache.hpp>
-#include <miopen/load_file.hpp>
 #include <boost/filesystem.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/gemm_geometry.hpp>
+#include <miopen/logger.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #ifndef _WIN32
@@ -247,6 +252,119 @@ void* default_allocator(void* context, size_t sz)
 
 void default_deallocator(void*, void* mem) { clReleaseMemObject(DataCast(mem)); }
 
+using EventPtr = std::shared_ptr<typename std::remove_pointer<cl_event>::type>;
+
+static EventPtr MakeEventPtr(cl_event e) { return {e, &clReleaseEvent}; }
+
+static bool IsOutOfOrder(cl_command_queue q)
+{
+    cl_command_queue_properties properties = 0;
+    clGetCommandQueueInfo(q, CL_QUEUE_PROPERTIES, sizeof(properties), &properties, nullptr);
+    return (properties & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE) != 0;
+}
+
+static Handle::Transfer WaitForTransfer(EventPtr event, const std::string& message)
+{
+    return std::async(std::launch::deferred,
+                      [ event = std::move(event), message ] {
+                          cl_event ev = event.get();
+                          auto status = clWaitForEvents(1, &ev);
+                          if(status != CL_SUCCESS)
+                          {
+                              MIOPEN_THROW_CL_STATUS(status, "OpenCL error " + message);
+                          }
+                      })
+        .share();
+}
+
+static Handle::Transfer DoneTransfer()
+{
+    std::promise<void> done;
+    done.set_value();
+    return done.get_future().share();
+}
+
+/// Pinned host memory that small transfers go through, so that they neither wait for the host
+/// nor need the host data to stay valid.
+struct StagingBuffer
+{
+    static constexpr std::size_t MinSize  = 64 * 1024;
+    static constexpr std::size_t MaxSize  = 16 * 1024 * 1024;
+    static constexpr std::size_t MaxCount = 4;
+
+    StagingBuffer(cl_command_queue q, std::size_t sz) : queue(q), size(MinSize)
+    {
+        while(size < sz)
+            size *= 2;
+        cl_int status = CL_SUCCESS;
+        mem           = clCreateBuffer(miopen::GetContext(q),
+                             CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR,
+                             size,
+                             nullptr,
+                             &status);
+        if(status != CL_SUCCESS)
+        {
+            MIOPEN_THROW_CL_STATUS(status,
+                                   "OpenCL error creating staging buffer: " + std::to_string(size));
+        }
+        // Mapping once waits for the queue, later transfers through the buffer do not.
+        host = clEnqueueMapBuffer(q,
+                                  mem,
+                                  CL_TRUE,
+                                  CL_MAP_READ | CL_MAP_WRITE,
+                                  0,
+                                  size,
+                                  0,
+                                  nullptr,
+                                  nullptr,
+                                  &status);
+        if(status != CL_SUCCESS)
+        {
+            clReleaseMemObject(mem);
+            MIOPEN_THROW_CL_STATUS(status, "OpenCL error mapping staging buffer");
+        }
+        clRetainCommandQueue(queue);
+    }
+    StagingBuffer(const StagingBuffer&) = delete;
+    StagingBuffer& operator=(const StagingBuffer&) = delete;
+    ~StagingBuffer()
+    {
+        clEnqueueUnmapMemObject(queue, mem, host, 0, nullptr, nullptr);
+        clReleaseMemObject(mem);
+        clReleaseCommandQueue(queue);
+    }
+
+    /// Whether the last transfer through the buffer is done, or failed.
+    bool IsIdle() const
+    {
+        if(event == nullptr)
+            return true;
+        cl_int status = CL_COMPLETE;
+        clGetEventInfo(event.get(),
+                       CL_EVENT_COMMAND_EXECUTION_STATUS,
+                       sizeof(status),
+                       &status,
+                       nullptr);
+        return status <= CL_COMPLETE;
+    }
+    void Wait() const
+    {
+        if(event == nullptr)
+            return;
+        cl_event ev = event.get();
+        clWaitForEvents(1, &ev);
+    }
+
+    cl_command_queue queue;
+    cl_mem mem = nullptr;
+    void* host = nullptr;
+    std::size_t size;
+    /// The last transfer through the buffer, set by the holder of the lease.
+    EventPtr event;
+    /// Set while a transfer holds the buffer, as a read copies from it when it is waited for.
+    std::atomic<bool> leased{false};
+};
+
 struct HandleImpl
 {
 
@@ -256,13 +374,71 @@ struct HandleImpl
     using ContextPtr = miopen::manage_ptr<typename std::remove_pointer<cl_context>::type,
                                           decltype(&clReleaseContext),
                                           &clReleaseContext>;
+    using SharedContextPtr = std::shared_ptr<typename std::remove_pointer<cl_context>::type>;
 
+    SharedContextPtr shared_context;
     ContextPtr context;
     AqPtr queue;
     Allocator allocator{};
+    MemoryPool pool;
+    std::shared_ptr<WorkspaceArena> workspace_arena;
     KernelCache cache;
     bool enable_profiling  = false;
+    bool precompile_only   = false;
     float profiling_result = 0.0;
+    std::shared_ptr<OCLKernelRecording> recording;
+    std::shared_ptr<KernelTrace> trace;
+    std::unordered_map<KernelKey, std::shared_ptr<OCLKernelRecording>, KernelKey::Hash> recordings;
+    std::mutex staging_mutex;
+    std::vector<std::shared_ptr<StagingBuffer>> staging;
+
+    /// Leases a staging buffer for a transfer of sz bytes on the queue, or returns nullptr if the
+    /// transfer should not be staged. The buffer is given back when the lease is released.
+    std::shared_ptr<StagingBuffer> lease_staging(cl_command_queue q, std::size_t sz)
+    {
+        if(sz > StagingBuffer::MaxSize)
+            return nullptr;
+        auto lease = [](std::shared_ptr<StagingBuffer>& buffer) {
+            auto b = buffer;
+            return std::shared_ptr<StagingBuffer>{
+                b.get(), [b](StagingBuffer*) { b->leased.store(false); }};
+        };
+        auto try_lease = [](StagingBuffer& buffer) {
+            bool expected = false;
+            return buffer.leased.compare_exchange_strong(expected, true);
+        };
+
+        std::lock_guard<std::mutex> lock(staging_mutex);
+        for(auto&& buffer : staging)
+        {
+            if(buffer->queue != q || buffer->size < sz || !try_lease(*buffer))
+                continue;
+            if(buffer->IsIdle())
+                return lease(buffer);
+            buffer->leased.store(false);
+        }
+        if(staging.size() < StagingBuffer::MaxCount)
+        {
+            staging.push_back(std::make_shared<StagingBuffer>(q, sz));
+            staging.back()->leased.store(true);
+            return lease(staging.back());
+        }
+        // Rather than pinning more memory, wait for a transfer to be done with its buffer.
+        for(auto&& buffer : staging)
+        {
+            if(!try_lease(*buffer))
+                continue;
+            buffer->Wait();
+            if(buffer->queue != q || buffer->size < sz)
+            {
+                auto b = std::make_shared<StagingBuffer>(q, sz);
+                b->leased.store(true);
+                buffer = b;
+            }
+            return lease(buffer);
+        }
+        return nullptr;
+    }
 
     ContextPtr create_context()
     {
@@ -313,6 +489,23 @@ struct HandleImpl
         }
         return result;
     }
+    // The default handles of the process use the same context, so that they can share the
+    // programs built by each other.
+    ContextPtr create_shared_context()
+    {
+        static std::mutex mutex;
+        static std::weak_ptr<typename std::remove_pointer<cl_context>::type> shared;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        shared_context = shared.lock();
+        if(shared_context == nullptr)
+        {
+            shared_context = SharedContextPtr{create_context().release(), &clReleaseContext};
+            shared         = shared_context;
+        }
+        clRetainContext(shared_context.get());
+        return ContextPtr{shared_context.get()};
+    }
     ContextPtr create_context_from_queue()
     {
         // FIXME: hack for all the queues on the same context
@@ -349,6 +542,7 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
     clRetainCommandQueue(stream);
     impl->queue   = HandleImpl::AqPtr{stream};
     impl->context = impl->create_context_from_queue();
+    impl->cache.SharePrograms(impl->context.get(), miopen::GetDevice(impl->queue.get()));
 
     this->SetAllocator(nullptr, nullptr, nullptr);
 }
@@ -359,7 +553,7 @@ Handle::Handle() : impl(new HandleImpl())
     // Create an OpenCL context
     /////////////////////////////////////////////////////////////////
 
-    impl->context = impl->create_context();
+    impl->context = impl->create_shared_context();
     /* First, get the size of device list data */
     cl_uint deviceListSize;
     if(clGetContextInfo(impl->context.get(),
@@ -425,6 +619,7 @@ Handle::Handle() : impl(new HandleImpl())
     {
         MIOPEN_THROW("Creating Command Queue. (clCreateCommandQueue)");
     }
+    impl->cache.SharePrograms(impl->context.get(), device);
     this->SetAllocator(nullptr, nullptr, nullptr);
 }
 
@@ -457,6 +652,42 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
 
     this->impl->allocator.context =
         allocatorContext == nullptr ? this->impl->context.get() : allocatorContext;
+
+    this->impl->pool.SetAllocator(this->impl->allocator);
+    this->impl->pool.SetCapacity(
+        allocator == nullptr
+            ? MemoryPool::GetDefaultCapacity(miopen::GetDeviceInfo<CL_DEVICE_GLOBAL_MEM_SIZE>(
+                  miopen::GetDevice(this->GetStream())))
+            : 0);
+}
+
+void Handle::SetMemoryPoolCapacity(std::size_t capacity) const
+{
+    this->impl->pool.SetCapacity(capacity);
+}
+
+void Handle::TrimMemoryPool() const { this->impl->pool.Trim(); }
+
+MemoryPoolStats Handle::GetMemoryPoolStats() const { return this->impl->pool.GetStats(); }
+
+void Handle::EnableWorkspaceArena(std::size_t limit)
+{
+    if(limit == this->GetWorkspaceArenaLimit())
+        return;
+    // The workspaces in use keep the previous arena.
+    this->impl->workspace_arena = limit == 0 ? nullptr : std::make_shared<WorkspaceArena>(limit);
+}
+
+std::size_t Handle::GetWorkspaceArenaLimit() const
+{
+    return this->impl->workspace_arena == nullptr ? 0 : this->impl->workspace_arena->GetLimit();
+}
+
+Workspace Handle::GetWorkspace(std::size_t sz)
+{
+    if(this->impl->workspace_arena == nullptr)
+        MIOPEN_THROW("The workspace arena is disabled");
+    return this->impl->workspace_arena->Get(*this, sz);
 }
 
 void Handle::EnableProfiling(bool enable) { this->impl->enable_profiling = enable; }
@@ -466,8 +697,51 @@ void Handle::AccumKernelTime(float curr_time) { this->impl->AccumProfilingResult
 
 float Handle::GetKernelTime() const { return this->impl->profiling_result; }
 
-KernelInvoke Handle::AddKernel(const std::string& algorithm,
-                               const std::string& network_config,
+static Program LoadCachedProgram(cl_context context,
+                                 cl_device_id device,
+                                 const std::string& device_name,
+                                 const std::string& program_name,
+                                 const std::string& params,
+                                 bool is_kernel_str)
+{
+    auto cache_binary = miopen::LoadBinary(device_name, program_name, params, is_kernel_str);
+    if(cache_binary.empty())
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        auto p = miopen::LoadProgram(context, device, program_name, params, is_kernel_str);
+
+        const auto compile_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      std::chrono::steady_clock::now() - start)
+                                      .count();
+
+        // Save to cache
+        auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
+        miopen::SaveProgramBinary(p, path.string());
+        miopen::SaveBinary(
+            path.string(), device_name, program_name, params, is_kernel_str, compile_time);
+
+        return std::move(p);
+    }
+    else
+    {
+        return LoadBinaryProgram(context, device, cache_binary);
+    }
+}
+
+// The context, device and device name are resolved in the calling thread, so that the loader does
+// not read the queue of the handle, which SetStream() may replace and release meanwhile.
+static KernelCache::ProgramLoader GetProgramLoader(Handle& h)
+{
+    const auto context     = miopen::GetContext(h.GetStream());
+    const auto device      = miopen::GetDevice(h.GetStream());
+    const auto device_name = h.GetDeviceName();
+    return [=](const std::string& program_name, const std::string& params, bool is_kernel_str) {
+        return LoadCachedProgram(context, device, device_name, program_name, params, is_kernel_str);
+    };
+}
+
+KernelInvoke Handle::AddKernel(const KernelKey& key,
                                const std::string& program_name,
                                const std::string& kernel_name,
                                const std::vector<size_t>& vld,
@@ -475,60 +749,150 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                const std::string& params,
                                std::size_t cache_index)
 {
+    if(this->impl->precompile_only)
+    {
+        const bool is_kernel_str = key.GetAlgorithm().GetName().find("GEMM") != std::string::npos;
+        this->impl->cache.Precompile(GetProgramLoader(*this), program_name, params, is_kernel_str);
+        return {};
+    }
 
     auto obj = this->impl->cache.AddKernel(
-        *this, algorithm, network_config, program_name, kernel_name, vld, vgd, params, cache_index);
-    return this->Run(obj);
+        *this, key, program_name, kernel_name, vld, vgd, params, cache_index);
+    return this->Run(obj, key);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config)
+void Handle::PrecompileProgram(const std::string& program_name,
+                               const std::string& params,
+                               bool is_kernel_str)
 {
-    return this->impl->cache.GetKernels(algorithm, network_config);
+    this->impl->cache.Precompile(GetProgramLoader(*this), program_name, params, is_kernel_str);
+}
+
+std::size_t Handle::WaitForPrecompiled(std::size_t& failed)
+{
+    const auto result = this->impl->cache.WaitForPrecompiled();
+    failed            = result.failed;
+    return result.built;
+}
+
+const std::vector<Kernel>& Handle::GetKernelsImpl(const KernelKey& key)
+{
+    if(this->impl->precompile_only)
+    {
+        static const std::vector<Kernel> none;
+        return none;
+    }
+    return this->impl->cache.GetKernels(key);
 }
 
 KernelInvoke Handle::Run(Kernel k)
 {
     auto q = this->GetStream();
+    KernelInvoke invoke;
     if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
     {
-        return k.Invoke(q,
-                        std::bind(&HandleImpl::SetProfilingResult,
-                                  std::ref(*this->impl),
-                                  std::placeholders::_1));
+        // Small enough for std::function not to allocate.
+        invoke = k.Invoke(
+            q, [impl = this->impl.get()](cl_event& e) { impl->SetProfilingResult(e); });
     }
     else
     {
-        return k.Invoke(q);
+        invoke = k.Invoke(q);
     }
+    invoke.recording = this->impl->recording;
+    invoke.trace     = this->impl->trace;
+    return invoke;
 }
 
-Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
+KernelInvoke Handle::Run(Kernel k, const KernelKey& key)
 {
-    auto cache_file =
-        miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
-    if(cache_file.empty())
-    {
-        auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
-                                     miopen::GetDevice(this->GetStream()),
-                                     program_name,
-                                     params,
-                                     is_kernel_str);
+    auto invoke = this->Run(std::move(k));
+    if(invoke.trace != nullptr)
+        invoke.network_config = key.ToString();
+    return invoke;
+}
 
-        // Save to cache
-        auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
-        miopen::SaveProgramBinary(p, path.string());
-        miopen::SaveBinary(
-            path.string(), this->GetDeviceName(), program_name, params, is_kernel_str);
+// Not to wait for each kernel, the trace reads the events only when it is read.
+static void ReadKernelTraceEvent(void* event, KernelTraceEntry& entry)
+{
+    auto ev = static_cast<cl_event>(event);
+    clWaitForEvents(1, &ev);
 
-        return std::move(p);
-    }
-    else
+    const auto read = [&](cl_profiling_info info, std::uint64_t& time) {
+        cl_ulong value = 0;
+        if(clGetEventProfilingInfo(ev, info, sizeof(value), &value, nullptr) == CL_SUCCESS)
+            time = value;
+    };
+    read(CL_PROFILING_COMMAND_QUEUED, entry.queued);
+    read(CL_PROFILING_COMMAND_START, entry.start);
+    read(CL_PROFILING_COMMAND_END, entry.end);
+}
+
+void Handle::EnableKernelTrace(std::size_t capacity)
+{
+    this->impl->trace =
+        capacity == 0 ? nullptr : std::make_shared<KernelTrace>(capacity, &ReadKernelTraceEvent);
+}
+
+std::vector<KernelTraceEntry> Handle::GetKernelTrace()
+{
+    if(this->impl->trace == nullptr)
+        return {};
+    return this->impl->trace->Get();
+}
+
+void Handle::BeginRecording()
+{
+    if(this->impl->recording != nullptr)
+        MIOPEN_THROW("Kernel launches are already being recorded");
+    this->impl->recording = std::make_shared<OCLKernelRecording>();
+}
+
+void Handle::EndRecording(const KernelKey& key, const std::vector<ConstData_t>& buffers)
+{
+    // Enough for the shapes a network is run with.
+    const std::size_t max_recordings = 256;
+
+    auto recording        = std::move(this->impl->recording);
+    this->impl->recording = nullptr;
+    if(recording == nullptr)
+        MIOPEN_THROW("Kernel launches are not being recorded");
+    if(!recording->Finish(buffers))
     {
-        return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
-                                 miopen::GetDevice(this->GetStream()),
-                                 miopen::LoadFile(cache_file));
+        MIOPEN_LOG_I2("Not kept, uses other buffers or the host memory: " << key.ToString());
+        return;
     }
+    // Nothing has been launched in the precompile-only mode.
+    if(!this->impl->precompile_only && this->impl->recordings.size() < max_recordings)
+        this->impl->recordings[key] = std::move(recording);
+}
+
+void Handle::CancelRecording()
+{
+    if(this->impl->recording != nullptr)
+        this->impl->recording->Finish({});
+    this->impl->recording = nullptr;
+}
+
+bool Handle::Replay(const KernelKey& key, const std::vector<ConstData_t>& buffers)
+{
+    if(this->impl->enable_profiling || this->impl->precompile_only || MIOPEN_GPU_SYNC)
+        return false;
+    const auto recording = this->impl->recordings.find(key);
+    if(recording == this->impl->recordings.end())
+        return false;
+    recording->second->Replay(this->GetStream(), buffers, this->impl->trace);
+    return true;
+}
+
+Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
+{
+    return LoadCachedProgram(miopen::GetContext(this->GetStream()),
+                             miopen::GetDevice(this->GetStream()),
+                             this->GetDeviceName(),
+                             program_name,
+                             params,
+                             is_kernel_str);
 }
 
 void Handle::Finish() const { clFinish(this->GetStream()); }
@@ -537,6 +901,10 @@ void Handle::Flush() const { clFlush(this->GetStream()); }
 
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
+void Handle::EnablePrecompileOnly(bool enable) { this->impl->precompile_only = enable; }
+
+bool Handle::IsPrecompileOnlyEnabled() const { return this->impl->precompile_only; }
+
 std::size_t Handle::GetLocalMemorySize()
 {
     return miopen::GetDeviceInfo<CL_DEVICE_LOCAL_MEM_SIZE>(miopen::GetDevice(this->GetStream()));
@@ -556,40 +924,116 @@ std::size_t Handle::GetMaxComputeUnits()
 Allocator::ManageDataPtr Handle::Create(std::size_t sz)
 {
     MIOPEN_HANDLE_LOCK
-    this->Finish();
-    return this->impl->allocator(sz);
+    // The queue is in order, so a released buffer is reused by kernels enqueued after the ones
+    // that used it. OpenCL frees buffers once their kernels are done, but a custom allocator may
+    // hand out memory that the enqueued kernels still use.
+    if(IsOutOfOrder(this->GetStream()))
+        this->Finish();
+    auto result = this->impl->pool.Reuse(sz);
+    if(result != nullptr)
+        return result;
+    if(this->impl->allocator.allocator != default_allocator)
+        this->Finish();
+    return this->impl->pool.Allocate(sz);
 }
 
 Allocator::ManageDataPtr&
 Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz)
+{
+    this->WriteToAsync(data, ddata.get(), sz).get();
+    return ddata;
+}
+
+void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz)
+{
+    this->ReadToAsync(data, ddata.get(), sz).get();
+}
+
+Handle::Transfer Handle::WriteToAsync(const void* data, Data_t ddata, std::size_t sz)
 {
     MIOPEN_HANDLE_LOCK
-    this->Finish();
-    cl_int status = clEnqueueWriteBuffer(
-        this->GetStream(), ddata.get(), CL_TRUE, 0, sz, data, 0, nullptr, nullptr);
+    if(this->impl->recording != nullptr)
+        this->impl->recording->Discard();
+    auto q = this->GetStream();
+    if(IsOutOfOrder(q))
+    {
+        this->Finish();
+        auto status = clEnqueueWriteBuffer(q, ddata, CL_TRUE, 0, sz, data, 0, nullptr, nullptr);
+        if(status != CL_SUCCESS)
+        {
+            MIOPEN_THROW_CL_STATUS(status, "OpenCL error writing to buffer: " + std::to_string(sz));
+        }
+        return DoneTransfer();
+    }
+
+    auto staging = this->impl->lease_staging(q, sz);
+    if(staging != nullptr)
+    {
+        std::memcpy(staging->host, data, sz);
+        data = staging->host;
+    }
+    cl_event ev = nullptr;
+    auto status = clEnqueueWriteBuffer(q, ddata, CL_FALSE, 0, sz, data, 0, nullptr, &ev);
     if(status != CL_SUCCESS)
     {
         MIOPEN_THROW_CL_STATUS(status, "OpenCL error writing to buffer: " + std::to_string(sz));
     }
-    return ddata;
+    auto event = MakeEventPtr(ev);
+    if(staging != nullptr)
+        staging->event = event;
+    this->Flush();
+    return WaitForTransfer(std::move(event), "writing to buffer: " + std::to_string(sz));
 }
 
-void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz)
+Handle::Transfer Handle::ReadToAsync(void* data, ConstData_t ddata, std::size_t sz)
 {
     MIOPEN_HANDLE_LOCK
-    this->Finish();
-    auto status = clEnqueueReadBuffer(
-        this->GetStream(), ddata.get(), CL_TRUE, 0, sz, data, 0, nullptr, nullptr);
+    if(this->impl->recording != nullptr)
+        this->impl->recording->Discard();
+    auto q = this->GetStream();
+    if(IsOutOfOrder(q))
+    {
+        this->Finish();
+        auto status = clEnqueueReadBuffer(q, ddata, CL_TRUE, 0, sz, data, 0, nullptr, nullptr);
+        if(status != CL_SUCCESS)
+        {
+            MIOPEN_THROW_CL_STATUS(status,
+                                   "OpenCL error reading from buffer: " + std::to_string(sz));
+        }
+        return DoneTransfer();
+    }
+
+    auto staging = this->impl->lease_staging(q, sz);
+    cl_event ev  = nullptr;
+    auto status  = clEnqueueReadBuffer(
+        q, ddata, CL_FALSE, 0, sz, staging ? staging->host : data, 0, nullptr, &ev);
     if(status != CL_SUCCESS)
     {
         MIOPEN_THROW_CL_STATUS(status, "OpenCL error reading from buffer: " + std::to_string(sz));
     }
+    auto event = MakeEventPtr(ev);
+    this->Flush();
+    auto transfer = WaitForTransfer(event, "reading from buffer: " + std::to_string(sz));
+    if(staging == nullptr)
+        return transfer;
+
+    staging->event = std::move(event);
+    // The staging buffer is held until the data is copied out of it.
+    return std::async(std::launch::deferred,
+                      [ transfer, staging = std::move(staging), data, sz ] {
+                          transfer.get();
+                          std::memcpy(data, staging->host, sz);
+                      })
+        .share();
 }
 
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size)
 {
     MIOPEN_HANDLE_LOCK
-    this->Finish();
+    if(this->impl->recording != nullptr)
+        this->impl->recording->AddCopy(src, dest, size);
+    if(IsOutOfOrder(this->GetStream()))
+        this->Finish();
     auto status =
         clEnqueueCopyBuffer(this->GetStream(), src, dest, 0, 0, size, 0, nullptr, nullptr);
     if(status != CL_SUCCESS)
@@ -30,6 +30,9 @@
 
 namespace miopen {
 
+static const KernelAlgorithm lrn_forward{"miopenLRNForward"};
+static const KernelAlgorithm lrn_backward{"miopenLRNBackward"};
+
 miopenStatus_t LRNDescriptor::Forward(Handle& handle,
                                       const void* /*alpha*/,
                                       const TensorDescriptor& xDesc,
@@ -103,18 +106,27 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
     if(float_equal(f_norm_K, 0.0))
         MIOPEN_THROW("Expect non-zero bias/K");
 
-    std::string algo_name = "miopenLRNForward";
-    std::string network_config =
-        std::to_string(f_norm_alpha) + std::to_string(f_norm_beta) + std::to_string(f_norm_K) +
-        std::to_string(f_norm_alphaoverarea) + std::to_string(local_ar) +
-        std::to_string(norm_region) + std::to_string(do_backward) +
-        std::to_string(xDesc.GetType()) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(nIn) + std::to_string(nOut) + std::to_string(nInStride) +
-        std::to_string(nOutStride) + std::to_string(cIn) + std::to_string(cOut) +
-        std::to_string(cInStride) + std::to_string(cOutStride) + std::to_string(hIn) +
-        std::to_string(hOut);
-
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    const KernelKey key{lrn_forward,
+                        {KernelKey::Pack(f_norm_alpha),
+                         KernelKey::Pack(f_norm_beta),
+                         KernelKey::Pack(f_norm_K),
+                         KernelKey::Pack(f_norm_alphaoverarea),
+                         local_ar,
+                         norm_region,
+                         do_backward ? 1 : 0,
+                         xDesc.GetType(),
+                         nIn,
+                         nOut,
+                         nInStride,
+                         nOutStride,
+                         cIn,
+                         cOut,
+                         cInStride,
+                         cOutStride,
+                         hIn,
+                         hOut}};
+
+    auto&& kernels = handle.GetKernels(key);
     if(!kernels.empty())
     {
         visit_float(xDesc.GetType(), [&](auto as_float) {
@@ -148,8 +160,8 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
         const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
-        KernelInvoke obj = handle.AddKernel(
-            algo_name, network_config, program_name, kernel_name, vld, vgd, compiler_parms);
+        KernelInvoke obj =
+            handle.AddKernel(key, program_name, kernel_name, vld, vgd, compiler_parms);
         visit_float(xDesc.GetType(), [&](auto as_float) {
             if(do_backward)
             {
@@ -279,18 +291,27 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
     if(float_equal(norm_K, 0.0))
         MIOPEN_THROW("Expect non-zero bias/K");
 
-    std::string algo_name = "miopenLRNBackward";
-    std::string network_config =
-        std::to_string(f_norm_alpha) + std::to_string(f_norm_beta) + std::to_string(norm_K) +
-        std::to_string(norm_alphaoverarea) + std::to_string(local_ar) +
-        std::to_string(norm_region) + std::to_string(f_norm_ratio) +
-        std::to_string(xDesc.GetType()) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(nIn) + std::to_string(nOut) + std::to_string(nInStride) +
-        std::to_string(nOutStride) + std::to_string(cIn) + std::to_string(cOut) +
-        std::to_string(cInStride) + std::to_string(cOutStride) + std::to_string(hIn) +
-        std::to_string(hOut);
-
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    const KernelKey key{lrn_backward,
+                        {KernelKey::Pack(f_norm_alpha),
+                         KernelKey::Pack(f_norm_beta),
+                         KernelKey::Pack(norm_K),
+                         KernelKey::Pack(norm_alphaoverarea),
+                         local_ar,
+                         norm_region,
+                         KernelKey::Pack(f_norm_ratio),
+                         xDesc.GetType(),
+                         nIn,
+                         nOut,
+                         nInStride,
+                         nOutStride,
+                         cIn,
+                         cOut,
+                         cInStride,
+                         cOutStride,
+                         hIn,
+                         hOut}};
+
+    auto&& kernels = handle.GetKernels(key);
     if(!kernels.empty())
     {
         visit_float(xDesc.GetType(), [&](auto as_float) {
@@ -315,8 +336,7 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
         const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
         visit_float(xDesc.GetType(), [&](auto as_float) {
-            handle.AddKernel(
-                algo_name, network_config, program_name, kernel_name, vld, vgd, compiler_parms)(
+            handle.AddKernel(key, program_name, kernel_name, vld, vgd, compiler_parms)(
                 y,
                 x,
                 dy,
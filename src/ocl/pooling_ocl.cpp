@@ -31,6 +31,9 @@
 
 namespace miopen {
 
+static const KernelAlgorithm pooling_forward{"miopenPooling2dForward"};
+static const KernelAlgorithm pooling_backward{"miopenPooling2dBackward"};
+
 std::size_t PoolingDescriptor::GetWorkSpaceSize(const TensorDescriptor& tensorDesc) const
 {
     return tensorDesc.GetElementSize() * sizeof(uint8_t);
@@ -108,19 +111,30 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     construct_params.setPoolingDescr(
         pooling_method, lens[0], lens[1], pads[0], pads[1], strides[0], strides[1]);
 
-    std::string network_config =
-        std::to_string(pooling_method) + std::to_string(do_backward) +
-        std::to_string(xDesc.GetType()) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(nIn) + std::to_string(nOut) + std::to_string(nInStride) +
-        std::to_string(nOutStride) + std::to_string(cIn) + std::to_string(cOut) +
-        std::to_string(cInStride) + std::to_string(cOutStride) + std::to_string(hIn) +
-        std::to_string(hOut) + std::to_string(hInStride) + std::to_string(hOutStride) +
-        std::to_string(lens[0]) + std::to_string(lens[1]) + std::to_string(strides[0]) +
-        std::to_string(strides[1]) + std::to_string(pads[0]) + std::to_string(pads[1]);
-
-    std::string algo_name = "miopenPooling2dForward";
-    // printf("Pooling forward network_config: %s\n", network_config.c_str());
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    const KernelKey key{pooling_forward,
+                        {pooling_method,
+                         do_backward ? 1 : 0,
+                         xDesc.GetType(),
+                         nIn,
+                         nOut,
+                         nInStride,
+                         nOutStride,
+                         cIn,
+                         cOut,
+                         cInStride,
+                         cOutStride,
+                         hIn,
+                         hOut,
+                         hInStride,
+                         hOutStride,
+                         lens[0],
+                         lens[1],
+                         strides[0],
+                         strides[1],
+                         pads[0],
+                         pads[1]}};
+
+    auto&& kernels = handle.GetKernels(key);
     if(!kernels.empty())
     {
         kernels.front()(x, y, workSpace);
@@ -136,8 +150,7 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
         const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
-        handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-            x, y, workSpace);
+        handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms)(x, y, workSpace);
     }
     if(miopen::CheckNumericsEnabled())
     {
@@ -251,19 +264,29 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     construct_params.setPoolingDescr(
         pooling_method, lens[0], lens[1], pads[0], pads[1], strides[0], strides[1]);
 
-    std::string network_config =
-        std::to_string(pooling_method) + std::to_string(xDesc.GetType()) +
-        std::to_string(nInStride) + std::to_string(nOutStride) + std::to_string(nIn) +
-        std::to_string(nOut) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(cIn) + std::to_string(cOut) + std::to_string(cInStride) +
-        std::to_string(cOutStride) + std::to_string(hIn) + std::to_string(hOut) +
-        std::to_string(hInStride) + std::to_string(hOutStride) + std::to_string(lens[0]) +
-        std::to_string(lens[1]) + std::to_string(strides[0]) + std::to_string(strides[1]) +
-        std::to_string(pads[0]) + std::to_string(pads[1]);
-    // printf("Pooling backward network_config: %s\n", network_config.c_str());
-    std::string algo_name = "miopenPooling2dBackward";
-
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    const KernelKey key{pooling_backward,
+                        {pooling_method,
+                         xDesc.GetType(),
+                         nIn,
+                         nOut,
+                         nInStride,
+                         nOutStride,
+                         cIn,
+                         cOut,
+                         cInStride,
+                         cOutStride,
+                         hIn,
+                         hOut,
+                         hInStride,
+                         hOutStride,
+                         lens[0],
+                         lens[1],
+                         strides[0],
+                         strides[1],
+                         pads[0],
+                         pads[1]}};
+
+    auto&& kernels = handle.GetKernels(key);
     if(!kernels.empty())
     {
         if(mode == miopenPoolingMax)
@@ -284,8 +307,7 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
         std::string program_name       = construct_params.getKernelFile(); // CL kernel filename
         std::string kernel_name        = construct_params.getKernelName(); // kernel name
         std::string parms              = construct_params.getCompilerOptions(); // kernel parameters
-        auto k =
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms);
+        auto k = handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms);
 
         if(mode == miopenPoolingMax)
         {
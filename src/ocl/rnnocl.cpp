@@ -42,7 +42,8 @@
 
 namespace miopen {
 
-// Assuming sequence length is set to > 0 otherwise throw exception.
+// The hundreds of small launches of a sequence are replayed from a recording after the first
+// call with the same descriptors, skipping their lookup and setup.
 void RNNDescriptor::RNNForwardInference(Handle& handle,
                                         const int seqLen,
                                         c_array_view<const miopenTensorDescriptor_t> xDesc,
@@ -62,6 +63,76 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                         Data_t workSpace,
                                         size_t workSpaceSize) const
 {
+    static const KernelAlgorithm algorithm{"miopenRNNForwardInference"};
+    const std::vector<ConstData_t> buffers = {x, hx, cx, w, y, hy, cy, workSpace};
+
+    KernelKey::Fields fields{static_cast<KernelKey::Field>(hsize),
+                             static_cast<KernelKey::Field>(nLayers),
+                             static_cast<KernelKey::Field>(nHiddenTensorsPerLayer),
+                             static_cast<KernelKey::Field>(workspaceScale),
+                             rnnMode,
+                             dirMode,
+                             algoMode,
+                             inputMode,
+                             biasMode,
+                             dataType,
+                             seqLen,
+                             static_cast<KernelKey::Field>(workSpaceSize),
+                             static_cast<KernelKey::Field>(wDesc.GetElementSize())};
+    for(const auto buffer : buffers)
+        fields.push_back(buffer != nullptr);
+    for(const auto length : hyDesc.GetLengths())
+        fields.push_back(length);
+    for(int i = 0; i < seqLen; i++)
+    {
+        for(const auto length : xDesc[i].GetLengths())
+            fields.push_back(length);
+        for(const auto length : yDesc[i].GetLengths())
+            fields.push_back(length);
+    }
+
+    handle.RecordOrReplay(KernelKey{algorithm, std::move(fields)}, buffers, [&]() {
+        RNNForwardInferenceKernels(handle,
+                                   seqLen,
+                                   xDesc,
+                                   x,
+                                   hxDesc,
+                                   hx,
+                                   cxDesc,
+                                   cx,
+                                   wDesc,
+                                   w,
+                                   yDesc,
+                                   y,
+                                   hyDesc,
+                                   hy,
+                                   cyDesc,
+                                   cy,
+                                   workSpace,
+                                   workSpaceSize);
+    });
+}
+
+// Assuming sequence length is set to > 0 otherwise throw exception.
+void RNNDescriptor::RNNForwardInferenceKernels(Handle& handle,
+                                               const int seqLen,
+                                               c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                               ConstData_t x,
+                                               const TensorDescriptor& hxDesc,
+                                               ConstData_t hx,
+                                               const TensorDescriptor& cxDesc,
+                                               ConstData_t cx,
+                                               const TensorDescriptor& wDesc,
+                                               ConstData_t w,
+                                               c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                               Data_t y,
+                                               const TensorDescriptor& hyDesc,
+                                               Data_t hy,
+                                               const TensorDescriptor& cyDesc,
+                                               Data_t cy,
+                                               Data_t workSpace,
+                                               size_t workSpaceSize) const
+{
 
     if(x == nullptr || w == nullptr || y == nullptr)
     {
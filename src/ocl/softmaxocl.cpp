@@ -30,6 +30,11 @@
 
 namespace miopen {
 
+static const KernelAlgorithm softmax_forward_one_batch{"SoftmaxForwardOneBatch"};
+static const KernelAlgorithm softmax_forward_multi_batch{"SoftmaxForwardMultiBatch"};
+static const KernelAlgorithm softmax_backward_one_batch{"SoftmaxBackwardOneBatch"};
+static const KernelAlgorithm softmax_backward_multi_batch{"SoftmaxBackwardMultiBatch"};
+
 int nextPow2(int v)
 {
 
@@ -85,13 +90,11 @@ miopenStatus_t SoftmaxForward(
         size_t workgroups = std::min(grid_size, 64 * 40 * 8);
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
-        std::string algo_name = "SoftmaxForwardOneBatch";
-        std::string network_config =
-            std::to_string(num_batch) + std::to_string(usefp16) + std::to_string(usefp32) +
-            std::to_string(vgd[0]) + std::to_string(vld[0]) + std::to_string(spatial_dim) +
-            std::to_string(grid_size) + std::to_string(workgroups) + std::to_string(c);
+        // The work sizes and the batch sizes are derived from these.
+        const KernelKey key{softmax_forward_one_batch,
+                            {num_batch, usefp16 ? 1 : 0, spatial_dim, grid_size, c}};
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        auto&& kernels = handle.GetKernels(key);
 
         if(!kernels.empty())
         {
@@ -107,7 +110,7 @@ miopenStatus_t SoftmaxForward(
             std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DMIOPEN_USE_FP16=" +
                                 std::to_string(usefp16) + " -DMIOPEN_USE_FP32=" +
                                 std::to_string(usefp32);
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms)(
                 y, c, grid_size, spatial_dim);
         }
     }
@@ -125,14 +128,10 @@ miopenStatus_t SoftmaxForward(
             (grid_size % num_batch == 0) ? (grid_size / num_batch) : (grid_size / num_batch + 1);
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
-        std::string algo_name = "SoftmaxForwardMultiBatch";
-        std::string network_config =
-            std::to_string(num_batch) + std::to_string(usefp16) + std::to_string(usefp32) +
-            std::to_string(vgd[0]) + std::to_string(vld[0]) + std::to_string(spatial_dim) +
-            std::to_string(grid_size) + std::to_string(workgroups) + std::to_string(c) +
-            std::to_string(u_batch_size) + std::to_string(batch_size);
+        const KernelKey key{softmax_forward_multi_batch,
+                            {num_batch, usefp16 ? 1 : 0, spatial_dim, grid_size, c}};
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        auto&& kernels = handle.GetKernels(key);
 
         if(!kernels.empty())
         {
@@ -148,7 +147,7 @@ miopenStatus_t SoftmaxForward(
                                 std::to_string(usefp16) + " -DMIOPEN_USE_FP32=" +
                                 std::to_string(usefp32);
 
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms)(
                 y, c, grid_size, spatial_dim);
         }
     }
@@ -208,13 +207,10 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
         size_t workgroups = std::min(grid_size, 64 * 40 * 8);
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
-        std::string algo_name = "SoftmaxBackwardOneBatch";
-        std::string network_config =
-            std::to_string(num_batch) + std::to_string(usefp16) + std::to_string(usefp32) +
-            std::to_string(vgd[0]) + std::to_string(vld[0]) + std::to_string(spatial_dim) +
-            std::to_string(grid_size) + std::to_string(workgroups) + std::to_string(c);
+        const KernelKey key{softmax_backward_one_batch,
+                            {num_batch, usefp16 ? 1 : 0, spatial_dim, grid_size, c}};
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        auto&& kernels = handle.GetKernels(key);
 
         if(!kernels.empty())
         {
@@ -227,7 +223,7 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
             std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DMIOPEN_USE_FP16=" +
                                 std::to_string(usefp16) + " -DMIOPEN_USE_FP32=" +
                                 std::to_string(usefp32);
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms)(
                 y, dx, c, grid_size, spatial_dim);
         }
     }
@@ -239,14 +235,10 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
             (grid_size % num_batch == 0) ? (grid_size / num_batch) : (grid_size / num_batch + 1);
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
-        std::string algo_name = "SoftmaxBackwardMultiBatch";
-        std::string network_config =
-            std::to_string(num_batch) + std::to_string(usefp16) + std::to_string(usefp32) +
-            std::to_string(vgd[0]) + std::to_string(vld[0]) + std::to_string(spatial_dim) +
-            std::to_string(grid_size) + std::to_string(workgroups) + std::to_string(c) +
-            std::to_string(u_batch_size) + std::to_string(batch_size);
+        const KernelKey key{softmax_backward_multi_batch,
+                            {num_batch, usefp16 ? 1 : 0, spatial_dim, grid_size, c}};
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        auto&& kernels = handle.GetKernels(key);
 
         if(!kernels.empty())
         {
@@ -261,7 +253,7 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
                                 std::to_string(u_batch_size) + " -DMIOPEN_USE_FP16=" +
                                 std::to_string(usefp16) + " -DMIOPEN_USE_FP32=" +
                                 std::to_string(usefp32);
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            handle.AddKernel(key, program_name, kernel_name, vld, vgd, parms)(
                 y, dx, c, grid_size, spatial_dim);
         }
     }
@@ -164,15 +164,14 @@ float SubSampleGPU(
     const std::
         tuple<std::string, std::string, std::string, std::vector<size_t>, std::vector<size_t>>&
             kernel_info,
-    std::string& network_config,
+    const KernelKey& key,
     ConstData_t in,
     Data_t out)
 {
     std::string program_name = "MIOpenUtilKernels3.cl";
     std::string kernel_name  = "SubSample";
 
-    handle.AddKernel("miopenConvolutionBwdWeightsAlgoDirect_Main",
-                     network_config,
+    handle.AddKernel(key,
                      program_name,
                      kernel_name,
                      std::get<4>(kernel_info),
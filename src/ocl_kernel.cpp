@@ -25,6 +25,9 @@
  *******************************************************************************/
 #include <miopen/oclkernel.hpp>
 #include <miopen/handle_lock.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 
 namespace miopen {
 
@@ -46,6 +49,163 @@ static std::string DimToFormattedString(const size_t* dims, size_t count)
 }
 #endif // !NDEBUG
 
+bool OCLKernelArgs::Update(std::size_t i, const void* value, std::size_t size)
+{
+    if(i >= args.size())
+        args.resize(i + 1);
+    auto& arg = args[i];
+
+    const auto local = value == nullptr;
+    if(!local && size > arg.value.size())
+    {
+        // Not worth keeping.
+        arg.known = false;
+        return true;
+    }
+    if(arg.known && arg.local == local && arg.size == size &&
+       (local || std::memcmp(arg.value.data(), value, size) == 0))
+        return false;
+
+    arg.known = true;
+    arg.local = local;
+    arg.size  = size;
+    if(!local)
+        std::memcpy(arg.value.data(), value, size);
+    return true;
+}
+
+void OCLKernelArgs::Reset(std::size_t i)
+{
+    if(i < args.size())
+        args[i].known = false;
+}
+
+void OCLKernelRecording::AddLaunch(const OCLKernelInvoke& invoke)
+{
+    launches.push_back({invoke.kernel,
+                        invoke.args,
+                        invoke.work_dim,
+                        invoke.global_work_offset,
+                        invoke.global_work_dim,
+                        invoke.local_work_dim,
+                        invoke.network_config,
+                        {}});
+}
+
+void OCLKernelRecording::AddCopy(cl_mem src, cl_mem dest, std::size_t size)
+{
+    launches.push_back({nullptr, nullptr, 0, {}, {}, {}, {}, {}, size});
+    AddArg(src);
+    AddArg(dest);
+}
+
+bool OCLKernelRecording::Finish(const std::vector<cl_mem>& recorded_buffers)
+{
+    active  = false;
+    buffers = recorded_buffers;
+
+    if(discarded)
+        return false;
+
+    for(const auto& launch : launches)
+    {
+        for(const auto& arg : launch.args)
+        {
+            if(!arg.buffer)
+                continue;
+            cl_mem buffer;
+            std::memcpy(&buffer, arg.value.data(), sizeof(buffer));
+            if(buffer != nullptr &&
+               std::find(buffers.begin(), buffers.end(), buffer) == buffers.end())
+                return false;
+        }
+    }
+    for(auto it = buffers.begin(); it != buffers.end(); ++it)
+    {
+        // A buffer given twice could not be told apart.
+        if(*it != nullptr && std::find(std::next(it), buffers.end(), *it) != buffers.end())
+            return false;
+    }
+    return true;
+}
+
+void OCLKernelRecording::Replay(cl_command_queue queue,
+                                const std::vector<cl_mem>& replay_buffers,
+                                const std::shared_ptr<KernelTrace>& trace) const
+{
+    assert(replay_buffers.size() == buffers.size());
+
+    for(const auto& launch : launches)
+    {
+        if(launch.kernel == nullptr)
+        {
+            MIOPEN_HANDLE_LOCK
+            const auto status = clEnqueueCopyBuffer(queue,
+                                                    ReplayBuffer(launch.args[0], replay_buffers),
+                                                    ReplayBuffer(launch.args[1], replay_buffers),
+                                                    0,
+                                                    0,
+                                                    launch.copy_size,
+                                                    0,
+                                                    nullptr,
+                                                    nullptr);
+            if(status != CL_SUCCESS)
+                MIOPEN_THROW_CL_STATUS(status,
+                                       "OpenCL error copying buffer: " +
+                                           std::to_string(launch.copy_size));
+            continue;
+        }
+
+        for(std::size_t i = 0; i < launch.args.size(); ++i)
+        {
+            const auto& arg   = launch.args[i];
+            const void* value = arg.value.empty() ? nullptr : arg.value.data();
+            cl_mem buffer     = nullptr;
+            if(arg.buffer)
+            {
+                buffer = ReplayBuffer(arg, replay_buffers);
+                value  = &buffer;
+            }
+
+            if(launch.kernel_args != nullptr && !arg.buffer &&
+               !launch.kernel_args->Update(i, value, arg.size))
+                continue;
+            cl_int status = clSetKernelArg(launch.kernel.get(), i, arg.size, value);
+            if(status != CL_SUCCESS)
+            {
+                if(launch.kernel_args != nullptr)
+                    launch.kernel_args->Reset(i);
+                MIOPEN_THROW("Error setting argument #" + std::to_string(i) + " to kernel: " +
+                             OpenCLErrorMessage(status));
+            }
+        }
+
+        OCLKernelInvoke{queue,
+                        launch.kernel,
+                        launch.work_dim,
+                        launch.global_work_offset,
+                        launch.global_work_dim,
+                        launch.local_work_dim,
+                        nullptr,
+                        launch.kernel_args,
+                        nullptr,
+                        trace,
+                        launch.network_config}
+            .run();
+    }
+}
+
+cl_mem OCLKernelRecording::ReplayBuffer(const Arg& arg,
+                                       const std::vector<cl_mem>& replay_buffers) const
+{
+    cl_mem buffer;
+    std::memcpy(&buffer, arg.value.data(), sizeof(buffer));
+    const auto recorded = std::find(buffers.begin(), buffers.end(), buffer);
+    if(buffer != nullptr && recorded != buffers.end())
+        buffer = replay_buffers[recorded - buffers.begin()];
+    return buffer;
+}
+
 void OCLKernelInvoke::run() const
 {
 #ifndef NDEBUG
@@ -64,6 +224,7 @@ void OCLKernelInvoke::run() const
     MIOPEN_HANDLE_LOCK
 
     cl_event ev;
+    const auto want_event = callback || trace != nullptr;
     /* way to run OCL group larger than 256
      * hack to ensure local_size == 0, just checking that the 1st dim is 0
      * may want to use a better solution*/
@@ -76,17 +237,23 @@ void OCLKernelInvoke::run() const
                                ((local_work_dim[0] == 0) ? nullptr : local_work_dim.data()),
                                0,
                                nullptr,
-                               callback ? &ev : nullptr);
+                               want_event ? &ev : nullptr);
 
     if(status != CL_SUCCESS)
     {
         MIOPEN_THROW_CL_STATUS(status, "Running kernel failed: ");
     }
-    else if(callback)
+    if(!want_event)
+        return;
+
+    KernelTrace::Event event{ev, [](void* e) { clReleaseEvent(static_cast<cl_event>(e)); }};
+    if(callback)
     {
         clWaitForEvents(1, &ev);
         callback(ev);
     }
+    if(trace != nullptr)
+        trace->Add(GetName(), network_config, std::move(event));
 }
 
 std::string OCLKernelInvoke::GetName() const
@@ -110,7 +277,8 @@ OCLKernelInvoke OCLKernel::Invoke(cl_command_queue q, std::function<void(cl_even
               << "Invoking kernel: " << GetName(); // grid size + \n in OCLKernelInvoke::run()
 #endif                                             // !NDEBUG
 
-    OCLKernelInvoke result{q, kernel, gdims.size(), {}, {}, {}, callback};
+    OCLKernelInvoke result{
+        q, kernel, gdims.size(), {}, {}, {}, std::move(callback), args, nullptr, nullptr, {}};
     std::copy(gdims.begin(), gdims.end(), result.global_work_dim.begin());
     std::copy(ldims.begin(), ldims.end(), result.local_work_dim.begin());
     return result;
@@ -27,6 +27,7 @@
 #include <array>
 #include <initializer_list>
 #include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/pooling.hpp>
 #include <numeric>
@@ -196,6 +197,32 @@ extern "C" miopenStatus_t miopenPoolingForward(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenPrecompilePoolingForward(miopenHandle_t handle,
+                               const miopenPoolingDescriptor_t poolDesc,
+                               const miopenTensorDescriptor_t xDesc,
+                               const miopenTensorDescriptor_t yDesc,
+                               bool do_backward)
+{
+
+    MIOPEN_LOG_FUNCTION(poolDesc, xDesc, yDesc, do_backward);
+    return miopen::try_([&] {
+        miopen::AutoPrecompileOnly precompile_only{miopen::deref(handle)};
+        const float alpha = 1;
+        const float beta  = 0;
+        miopen::deref(poolDesc).Forward(miopen::deref(handle),
+                                        &alpha,
+                                        miopen::deref(xDesc),
+                                        precompile_only.GetBuffer(),
+                                        &beta,
+                                        miopen::deref(yDesc),
+                                        precompile_only.GetBuffer(),
+                                        do_backward,
+                                        precompile_only.GetBuffer(),
+                                        0);
+    });
+}
+
 extern "C" miopenStatus_t miopenPoolingBackward(miopenHandle_t handle,
                                                 const miopenPoolingDescriptor_t poolDesc,
                                                 const void* alpha,
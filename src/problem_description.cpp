@@ -0,0 +1,194 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/char_conv.hpp>
+#include <miopen/mlo_internal.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace miopen {
+
+namespace {
+
+// Weights of the numbers of a serialized problem config, in order of
+// ProblemDescription::Serialize(). The filter geometry and the number of channels affect
+// the best performance config of a solver most, the batch and the image sizes affect least.
+const std::array<double, 16>& DistanceWeights()
+{
+    // clang-format off
+    static const std::array<double, 16> weights = {{
+        4,      // n_inputs
+        1, 1,   // in_height, in_width
+        16, 16, // kernel_size1, kernel_size0
+        4,      // n_outputs
+        1, 1,   // out_height, out_width
+        0.5,    // batch_sz
+        8, 8,   // pad1, pad0
+        16, 16, // kernel_stride1, kernel_stride0
+        16, 16, // kernel_dilation1, kernel_dilation0
+        2,      // bias
+    }};
+    // clang-format on
+    return weights;
+}
+
+struct ParsedProblem
+{
+    std::array<long, 16> numbers;
+    std::size_t n_numbers = 0;
+    std::array<std::string, 3> names; // layout, data type, direction
+};
+
+bool ParseNumber(const char* first, const char* last, ParsedProblem& problem)
+{
+    long value = 0;
+
+    if(problem.n_numbers >= problem.numbers.size() || !FromChars(first, last, value) ||
+       value < 0)
+        return false;
+    problem.numbers[problem.n_numbers++] = value;
+    return true;
+}
+
+bool ParseProblem(const std::string& key, ParsedProblem& problem)
+{
+    constexpr std::size_t n_fields  = 15;
+    constexpr std::size_t n_numeric = 12;
+
+    auto first      = key.data();
+    const auto last = key.data() + key.size();
+    std::size_t n   = 0;
+
+    for(; first != last; ++n)
+    {
+        const auto end = std::find(first, last, '-');
+
+        if(n >= n_fields)
+            return false;
+
+        if(n >= n_numeric)
+        {
+            problem.names[n - n_numeric].assign(first, end);
+        }
+        else
+        {
+            const auto x = std::find(first, end, 'x');
+
+            if(x == end)
+            {
+                if(!ParseNumber(first, end, problem))
+                    return false;
+            }
+            else if(!ParseNumber(first, x, problem) || !ParseNumber(x + 1, end, problem))
+            {
+                return false;
+            }
+        }
+
+        first = end == last ? last : end + 1;
+    }
+
+    return n == n_fields && problem.n_numbers == DistanceWeights().size();
+}
+
+} // namespace
+
+bool ProblemDescription::Deserialize(const std::string& key)
+{
+    ParsedProblem problem;
+
+    if(!ParseProblem(key, problem))
+        return false;
+
+    ProblemDescription result;
+    const auto& direction_name = problem.names[2];
+
+    if(direction_name == "F")
+        result.direction.Set(1);
+    else if(direction_name == "B")
+        result.direction.Set(0);
+    else if(direction_name == "W")
+        result.direction.SetBackwardWrW();
+    else
+        return false;
+
+    auto number = problem.numbers.begin();
+    for(auto field : {&result.n_inputs,
+                      &result.in_height,
+                      &result.in_width,
+                      &result.kernel_size1,
+                      &result.kernel_size0,
+                      &result.n_outputs,
+                      &result.out_height,
+                      &result.out_width,
+                      &result.batch_sz,
+                      &result.pad1,
+                      &result.pad0,
+                      &result.kernel_stride1,
+                      &result.kernel_stride0,
+                      &result.kernel_dilation1,
+                      &result.kernel_dilation0,
+                      &result.bias})
+        *field = static_cast<int>(*number++);
+
+    result.in_layout    = problem.names[0];
+    result.in_data_type = problem.names[1];
+    result.float_size   = result.in_data_type == "FP16" ? 16 : 32;
+
+    *this = result;
+    return true;
+}
+
+DbKeyDistance ProblemDescription::GetDistance() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+
+    ParsedProblem query;
+    const auto valid = ParseProblem(ss.str(), query);
+
+    return [query, valid](const std::string& other) {
+        const auto infinity = std::numeric_limits<double>::infinity();
+        ParsedProblem problem;
+
+        if(!valid || !ParseProblem(other, problem) || problem.names != query.names)
+            return infinity;
+
+        const auto& weights = DistanceWeights();
+        auto distance       = 0.0;
+
+        for(std::size_t i = 0; i < weights.size(); ++i)
+            distance += weights[i] * std::fabs(std::log2(query.numbers[i] + 1.0) -
+                                               std::log2(problem.numbers[i] + 1.0));
+        return distance;
+    };
+}
+
+} // namespace miopen
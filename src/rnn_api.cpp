@@ -589,6 +589,13 @@ extern "C" miopenStatus_t miopenRNNForwardInference(miopenHandle_t handle,
     return miopen::try_([&] {
         miopen::c_array_view<const miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
         miopen::c_array_view<const miopenTensorDescriptor_t> yDescArray{yDesc, size_t(sequenceLen)};
+        // Training keeps its workspace from one call to the next, so only inference uses the
+        // workspace arena.
+        auto arena_workspace =
+            miopen::deref(handle).UseWorkspaceArena(workSpace, workSpaceNumBytes, [&] {
+                return miopen::deref(rnnDesc).GetWorkspaceSize(
+                    miopen::deref(handle), sequenceLen, xDescArray);
+            });
         miopen::deref(rnnDesc).RNNForwardInference(miopen::deref(handle),
                                                    sequenceLen,
                                                    xDescArray,
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/softmax.hpp>
 
@@ -48,6 +49,24 @@ extern "C" miopenStatus_t miopenSoftmaxForward(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t miopenPrecompileSoftmaxForward(miopenHandle_t handle,
+                                                         const miopenTensorDescriptor_t xDesc,
+                                                         const miopenTensorDescriptor_t yDesc)
+{
+    MIOPEN_LOG_FUNCTION(xDesc, yDesc);
+    return miopen::try_([&] {
+        // The copy of x to y, if it needs a kernel, is not precompiled.
+        miopen::AutoPrecompileOnly precompile_only{miopen::deref(handle)};
+        const float alpha = 1;
+        const float beta  = 0;
+        miopen::SoftmaxForward(miopen::deref(handle),
+                               &alpha,
+                               &beta,
+                               miopen::deref(yDesc),
+                               precompile_only.GetBuffer());
+    });
+}
+
 miopenStatus_t miopenSoftmaxBackward(miopenHandle_t handle,
                                      const void* alpha,
                                      const miopenTensorDescriptor_t yDesc,
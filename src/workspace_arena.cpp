@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/workspace_arena.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace miopen {
+
+static std::size_t AlignUp(std::size_t n)
+{
+    return (n + WorkspaceStack::Alignment - 1) / WorkspaceStack::Alignment *
+           WorkspaceStack::Alignment;
+}
+
+std::size_t WorkspaceStack::Push(std::size_t sz)
+{
+    const auto offset = blocks.empty() ? 0 : AlignUp(blocks.back().offset + blocks.back().size);
+    required          = std::max(required, offset + sz);
+    if(offset + sz > capacity)
+        return NoSpace;
+    blocks.push_back({offset, sz, true});
+    return offset;
+}
+
+void WorkspaceStack::Pop(std::size_t offset)
+{
+    auto it = std::find_if(
+        blocks.rbegin(), blocks.rend(), [&](const Block& b) { return b.offset == offset; });
+    assert(it != blocks.rend() && it->used);
+    it->used = false;
+    while(!blocks.empty() && !blocks.back().used)
+        blocks.pop_back();
+}
+
+void WorkspaceStack::SetCapacity(std::size_t capacity_)
+{
+    assert(this->IsEmpty());
+    capacity = capacity_;
+}
+
+WorkspaceArena::WorkspaceArena(std::size_t limit_) : limit(limit_)
+{
+    if(limit == 0)
+        MIOPEN_THROW(miopenStatusBadParm, "The workspace arena must hold at least one byte");
+}
+
+Workspace WorkspaceArena::Get(Handle& handle, std::size_t sz)
+{
+    Workspace result;
+    if(sz == 0)
+        return result;
+    result.size = sz;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if(sz <= limit)
+    {
+        const auto needed = std::min(limit, std::max(sz, stack.GetRequired()));
+        if(stack.IsEmpty() && stack.GetCapacity() < needed)
+        {
+            // The kernels that use the old buffer are enqueued before the ones that will use the
+            // new one, which may be the same memory.
+            buffer = nullptr;
+            stack.SetCapacity(0);
+            buffer = handle.Create(needed);
+            stack.SetCapacity(needed);
+            MIOPEN_LOG_I2("Workspace arena grown to " << needed << " bytes");
+        }
+        const auto offset = stack.Push(sz);
+        if(offset != WorkspaceStack::NoSpace)
+        {
+            result.data    = handle.CreateSubBuffer(buffer.get(), offset, sz);
+            auto self      = this->shared_from_this();
+            result.release = std::shared_ptr<void>(nullptr, [self, offset](void*) {
+                std::lock_guard<std::mutex> release_lock(self->mutex);
+                self->stack.Pop(offset);
+            });
+            return result;
+        }
+    }
+    lock.unlock();
+
+    result.data = handle.Create(sz);
+    return result;
+}
+
+} // namespace miopen
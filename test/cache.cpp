@@ -26,6 +26,9 @@
 
 #include <miopen/binary_cache.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
 #include "test.hpp"
 
 void check_cache_file()
@@ -41,8 +44,94 @@ void check_cache_str()
     CHECK(p.filename().string() == name + ".o");
 }
 
+void check_archive()
+{
+    miopen::TmpDir dir("binary_archive");
+    const std::string binary0("binary\0zero", 11);
+    const std::string binary1 = "binary one";
+    const std::string binary2 = "binary two";
+
+    {
+        miopen::BinaryArchive archive(dir.path);
+        CHECK(!archive.Load("key0"));
+        CHECK(archive.Save("key0", binary0));
+        CHECK(archive.Save("key1", binary1));
+        CHECK(archive.Load("key0") && *archive.Load("key0") == binary0);
+        CHECK(archive.Load("key1") && *archive.Load("key1") == binary1);
+    }
+
+    // Another instance (e.g. in another process) sees binaries saved by both, the last wins.
+    miopen::BinaryArchive reader(dir.path);
+    CHECK(reader.Load("key1") && *reader.Load("key1") == binary1);
+    {
+        miopen::BinaryArchive writer(dir.path);
+        CHECK(writer.Save("key1", binary2));
+        CHECK(writer.Save("key2", binary2));
+    }
+    CHECK(reader.Load("key2") && *reader.Load("key2") == binary2);
+    CHECK(reader.Load("key0") && *reader.Load("key0") == binary0);
+
+    // A partially written index entry is ignored and then dropped by the next writer.
+    {
+        std::ofstream index(reader.IndexPath().string(), std::ios::binary | std::ios::app);
+        index << "partial";
+    }
+    {
+        miopen::BinaryArchive writer(dir.path);
+        CHECK(writer.Load("key2") && *writer.Load("key2") == binary2);
+        CHECK(writer.Save("key3", binary1));
+    }
+    CHECK(boost::filesystem::file_size(reader.IndexPath()) % 64 == 0);
+    CHECK(reader.Load("key3") && *reader.Load("key3") == binary1);
+    CHECK(miopen::BinaryArchive(dir.path).Load("key1") &&
+          *miopen::BinaryArchive(dir.path).Load("key1") == binary2);
+}
+
+void check_archive_limit()
+{
+    miopen::TmpDir dir("binary_archive_limit");
+    const std::string binary(200, 'b');
+    miopen::BinaryArchive reader(dir.path);
+
+    {
+        // 240 bytes per binary with its header, compacted to 750 bytes once above 1000.
+        miopen::BinaryArchive writer(dir.path, 1000);
+        for(auto i = 0; i < 6; ++i)
+        {
+            CHECK(writer.Save("key" + std::to_string(i), binary, 10));
+            CHECK(reader.Load("key" + std::to_string(i)));
+        }
+
+        CHECK(boost::filesystem::file_size(writer.DataPath()) == 4 * 240);
+        CHECK(!writer.Load("key0"));
+        CHECK(!writer.Load("key1"));
+        CHECK(writer.Load("key2"));
+        CHECK(writer.Load("key5") && *writer.Load("key5") == binary);
+
+        const auto stats = writer.GetStats();
+        CHECK(stats.evictions == 2);
+        CHECK(stats.bytes_evicted == 2 * binary.size());
+        CHECK(stats.misses == 2);
+    }
+
+    // Readers detect that the files were replaced.
+    CHECK(reader.Load("key5") && *reader.Load("key5") == binary);
+    CHECK(reader.Load("key3") && *reader.Load("key3") == binary);
+
+    miopen::BinaryArchive other(dir.path);
+    CHECK(other.Load("key4"));
+    CHECK(!other.Load("key1"));
+    const auto stats = other.GetStats();
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 1);
+    CHECK(stats.bytes_read == binary.size());
+    CHECK(stats.compile_time_avoided == 10);
+}
+
 int main()
 {
     check_cache_file();
     check_cache_str();
+    check_archive();
+    check_archive_limit();
 }
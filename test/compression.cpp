@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compression.hpp>
+#include <random>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+bool decompress(const std::vector<unsigned char>& block, std::size_t size, std::string& result)
+{
+    return miopen::DecompressBlock(block.data(), size, &result[0], result.size());
+}
+
+void check_round_trip(const std::string& data)
+{
+    const auto compressed = miopen::CompressBlock(data.data(), data.size());
+    std::string result(data.size(), '\0');
+    CHECK(decompress(compressed, compressed.size(), result));
+    CHECK(result == data);
+    // The size must match exactly.
+    std::string larger(data.size() + 1, '\0');
+    CHECK(!decompress(compressed, compressed.size(), larger));
+}
+
+void check_sources()
+{
+    check_round_trip("");
+    check_round_trip("a");
+    check_round_trip("abcdefghijkl");
+    check_round_trip(std::string(1000, 'x'));
+
+    std::string source;
+    for(int i = 0; i < 200; ++i)
+        source += "#define MLO_SIZE" + std::to_string(i) + " " + std::to_string(i * 7) + "\n";
+    check_round_trip(source);
+
+    const auto compressed = miopen::CompressBlock(source.data(), source.size());
+    CHECK(compressed.size() < source.size() / 2);
+}
+
+void check_random()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> letter('a', 'd');
+    std::string noise;
+    std::string text;
+    // Longer than the 64K window, so that far matches are not used.
+    for(int i = 0; i < 100000; ++i)
+    {
+        noise += static_cast<char>(byte(gen));
+        text += static_cast<char>(letter(gen));
+    }
+    check_round_trip(noise);
+    check_round_trip(text);
+    check_round_trip(noise.substr(0, 70000) + noise.substr(0, 70000));
+}
+
+void check_malformed()
+{
+    const std::string data(300, 'y');
+    auto compressed = miopen::CompressBlock(data.data(), data.size());
+    std::string result(data.size(), '\0');
+
+    CHECK(!decompress(compressed, compressed.size() - 1, result));
+
+    // Offset beyond the decompressed data.
+    compressed[2] = 0xff;
+    compressed[3] = 0xff;
+    CHECK(!decompress(compressed, compressed.size(), result));
+}
+
+int main()
+{
+    check_sources();
+    check_random();
+    check_malformed();
+}
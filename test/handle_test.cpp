@@ -1,6 +1,7 @@
 
 #include <miopen/handle.hpp>
 #include "get_handle.hpp"
+#include <algorithm>
 #include <vector>
 #include <thread>
 #include "test.hpp"
@@ -22,11 +23,83 @@ void run(miopen::Handle& h, std::size_t n)
     CHECK(data_out == data_in);
 }
 
+void run_precompiled(miopen::Handle& h, std::size_t n)
+{
+    h.PrecompileProgram(Write2s(), "", true);
+    run(h, n);
+}
+
+void run_precompile_only(miopen::Handle& h, std::size_t n)
+{
+    std::vector<int> data_in(n, 1);
+    auto data_dev = h.Write(data_in);
+
+    h.EnablePrecompileOnly();
+    h.AddKernel("GEMM", "", Write2s(), "write", {n, 1, 1}, {n, 1, 1}, "")(data_dev.get());
+    CHECK(h.GetKernelsImpl("GEMM", "").empty());
+    h.EnablePrecompileOnly(false);
+
+    std::size_t n_failed = 0;
+    h.WaitForPrecompiled(n_failed);
+    CHECK(n_failed == 0);
+    CHECK(h.Read<int>(data_dev, n) == data_in);
+}
+
+void run_async(miopen::Handle& h, std::size_t n, std::size_t reads)
+{
+    std::vector<int> data_in(n, 1);
+    auto data_dev = h.Create<int>(n);
+    h.WriteToAsync(data_in.data(), data_dev.get(), n * sizeof(int)).get();
+
+    const std::size_t local = std::min<std::size_t>(n, 64);
+    h.AddKernel("GEMM", "", Write2s(), "write", {local, 1, 1}, {n, 1, 1}, "")(data_dev.get());
+    std::fill(data_in.begin(), data_in.end(), 2);
+
+    std::vector<std::vector<int>> data_out(reads, std::vector<int>(n));
+    std::vector<miopen::Handle::Transfer> transfers;
+    for(auto&& out : data_out)
+        transfers.push_back(h.ReadToAsync(out.data(), data_dev.get(), n * sizeof(int)));
+    for(std::size_t i = 0; i < reads; i++)
+    {
+        transfers[i].get();
+        CHECK(data_out[i] == data_in);
+    }
+}
+
+void run_workspace(miopen::Handle& h, std::size_t n)
+{
+    h.EnableWorkspaceArena(1024 * 1024);
+    for(int i = 0; i < 2; i++)
+    {
+        // The arena grows to hold both workspaces once they are released.
+        auto w1 = h.GetWorkspace(n * sizeof(int));
+        auto w2 = h.GetWorkspace(n * sizeof(int));
+        CHECK(w1.Get() != nullptr);
+        CHECK(w2.Get() != nullptr);
+        CHECK(w2.GetSize() == n * sizeof(int));
+
+        std::vector<int> data_in(n, 1);
+        h.WriteToAsync(data_in.data(), w2.Get(), n * sizeof(int)).get();
+        h.AddKernel("GEMM", "", Write2s(), "write", {n, 1, 1}, {n, 1, 1}, "")(w2.Get());
+        std::fill(data_in.begin(), data_in.end(), 2);
+        std::vector<int> data_out(n);
+        h.ReadToAsync(data_out.data(), w2.Get(), n * sizeof(int)).get();
+        CHECK(data_out == data_in);
+    }
+    h.EnableWorkspaceArena(0);
+    CHECK(h.GetWorkspaceArenaLimit() == 0);
+}
+
 int main()
 {
     auto&& h = get_handle();
+    run_precompile_only(h, 8);
+    run_precompiled(h, 8);
     std::thread([&] { run(h, 16); }).join();
     std::thread([&] { run(h, 32); }).join();
     std::thread([&] { std::thread([&] { run(h, 64); }).join(); }).join();
     run(h, 4);
+    run_async(h, 8, 8);
+    run_async(h, 8 * 1024 * 1024, 1);
+    run_workspace(h, 16);
 }
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_key.hpp>
+#include <string>
+#include "test.hpp"
+
+void check_interning()
+{
+    const miopen::KernelAlgorithm a{"miopenTestAlgo"};
+    const miopen::KernelAlgorithm b{std::string("miopenTest") + "Algo"};
+    const miopen::KernelAlgorithm c{"miopenTestAlgo_pass2"};
+    CHECK(a == b);
+    CHECK(a != c);
+    CHECK(b.GetName() == "miopenTestAlgo");
+    CHECK(c.GetName() == "miopenTestAlgo_pass2");
+}
+
+void check_typed()
+{
+    const miopen::KernelAlgorithm algo{"miopenTestAlgo"};
+    const miopen::KernelAlgorithm other{"miopenOtherAlgo"};
+    const miopen::KernelKey key{algo, {16, 28, 28, 3, 3, miopen::KernelKey::Pack("NCHW")}};
+    const miopen::KernelKey same{algo, {16, 28, 28, 3, 3, miopen::KernelKey::Pack("NCHW")}};
+    CHECK(key == same);
+    CHECK(key.GetHash() == same.GetHash());
+    CHECK(key != (miopen::KernelKey{algo, {16, 28, 28, 3, 3, miopen::KernelKey::Pack("CHWN")}}));
+    CHECK(key != (miopen::KernelKey{algo, {16, 28, 28, 3, 3}}));
+    CHECK(key != (miopen::KernelKey{other, {16, 28, 28, 3, 3, miopen::KernelKey::Pack("NCHW")}}));
+    // Concatenated strings used to collide here.
+    CHECK((miopen::KernelKey{algo, {1, 23}}) != (miopen::KernelKey{algo, {12, 3}}));
+    CHECK(miopen::KernelKey::Pack(0.5f) == miopen::KernelKey::Pack(0.5));
+    CHECK(miopen::KernelKey::Pack(0.5) != miopen::KernelKey::Pack(0.5000001));
+    CHECK(!key.IsEmpty());
+
+    miopen::KernelKey::Fields fields;
+    for(int i = 0; i < 40; ++i)
+        fields.push_back(i);
+    const miopen::KernelKey long_key{algo, fields};
+    CHECK(long_key == (miopen::KernelKey{algo, fields}));
+    fields.back() = 0;
+    CHECK(long_key != (miopen::KernelKey{algo, fields}));
+    CHECK(key.ToString() == "miopenTestAlgo, 16x28x28x3x3x" +
+                                std::to_string(miopen::KernelKey::Pack("NCHW")));
+}
+
+void check_string()
+{
+    const std::string config = "16x28x28x3x3x64x26x26x100xNCHWxFP32x1";
+    const miopen::KernelKey key{"miopenTestAlgo", config};
+    CHECK(key == (miopen::KernelKey{miopen::KernelAlgorithm{"miopenTestAlgo"}, config}));
+    CHECK(key != (miopen::KernelKey{"miopenTestAlgo", config + "x1"}));
+    CHECK(key != (miopen::KernelKey{"miopenTestAlgo", config.substr(0, 8)}));
+    CHECK(key.ToString() == "miopenTestAlgo, " + config);
+    CHECK(!key.IsEmpty());
+    CHECK((miopen::KernelKey{"miopenTestAlgo", ""}).IsEmpty());
+    CHECK((miopen::KernelKey{"", config}).IsEmpty());
+    CHECK((miopen::KernelKey{"miopenTestAlgo", ""}).ToString() == "miopenTestAlgo, ");
+}
+
+int main()
+{
+    check_interning();
+    check_typed();
+    check_string();
+}
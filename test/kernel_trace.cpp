@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_trace.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "test.hpp"
+
+// The events of the test are the times of the kernels.
+static void read_event(void* event, miopen::KernelTraceEntry& entry)
+{
+    const auto time = *static_cast<std::uint64_t*>(event);
+    entry.queued    = time;
+    entry.start     = time + 1000;
+    entry.end       = time + 3500;
+}
+
+static miopen::KernelTrace::Event make_event(std::uint64_t time)
+{
+    return std::make_shared<std::uint64_t>(time);
+}
+
+void check_ring()
+{
+    miopen::KernelTrace trace{3, &read_event};
+    CHECK(trace.Get().empty());
+
+    trace.Add("first", "1x2", make_event(0));
+    trace.Add("second", "3x4", make_event(10000));
+    auto entries = trace.Get();
+    CHECK(entries.size() == 2);
+    CHECK(entries[0].kernel_name == "first");
+    CHECK(entries[0].network_config == "1x2");
+    CHECK(entries[1].kernel_name == "second");
+    CHECK(entries[1].queued == 10000);
+    CHECK(entries[1].start == 11000);
+    CHECK(entries[1].end == 13500);
+
+    trace.Add("third", "", make_event(20000));
+    trace.Add("fourth", "", make_event(30000));
+    entries = trace.Get();
+    CHECK(entries.size() == 3);
+    CHECK(entries[0].kernel_name == "second");
+    CHECK(entries[2].kernel_name == "fourth");
+    CHECK(entries[2].start == 31000);
+}
+
+void check_chrome_trace()
+{
+    miopen::KernelTrace trace{4, &read_event};
+    trace.Add("MIOpenConv1x1", "miopenConvolutionFwdAlgoDirect, \"quoted\"", make_event(2000));
+    std::ostringstream json;
+    miopen::WriteChromeTrace(json, trace.Get());
+    const auto text = json.str();
+
+    CHECK(text.find("{\"traceEvents\":[") == 0);
+    CHECK(text.find("\"name\":\"MIOpenConv1x1\"") != std::string::npos);
+    CHECK(text.find("\"ph\":\"X\"") != std::string::npos);
+    CHECK(text.find("\"ts\":3.000") != std::string::npos);
+    CHECK(text.find("\"dur\":2.500") != std::string::npos);
+    CHECK(text.find("\\\"quoted\\\"") != std::string::npos);
+
+    std::ostringstream empty;
+    miopen::WriteChromeTrace(empty, {});
+    CHECK(empty.str().find("\"traceEvents\":[\n]") != std::string::npos);
+}
+
+int main()
+{
+    check_ring();
+    check_chrome_trace();
+}
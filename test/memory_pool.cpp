@@ -0,0 +1,185 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/memory_pool.hpp>
+#include <cstdlib>
+#include <set>
+#include "test.hpp"
+
+// Counts the buffers the allocator holds.
+struct heap
+{
+    std::set<void*> buffers;
+    std::size_t allocations = 0;
+    bool fail               = false;
+
+    static void* allocate(void* context, std::size_t n)
+    {
+        auto& h = *static_cast<heap*>(context);
+        if(h.fail)
+            return nullptr;
+        auto* buffer = std::malloc(n);
+        h.buffers.insert(buffer);
+        ++h.allocations;
+        return buffer;
+    }
+
+    static void deallocate(void* context, void* buffer)
+    {
+        auto& h = *static_cast<heap*>(context);
+        CHECK(h.buffers.erase(buffer) == 1);
+        std::free(buffer);
+    }
+
+    miopen::Allocator get() { return {&allocate, &deallocate, this}; }
+};
+
+void check_size_classes()
+{
+    CHECK(miopen::MemoryPool::GetSizeClass(0) == 256);
+    CHECK(miopen::MemoryPool::GetSizeClass(256) == 256);
+    CHECK(miopen::MemoryPool::GetSizeClass(300) == 320);
+    CHECK(miopen::MemoryPool::GetSizeClass(512) == 512);
+    CHECK(miopen::MemoryPool::GetSizeClass(1000) == 1024);
+    CHECK(miopen::MemoryPool::GetSizeClass(1100) == 1280);
+    for(std::size_t n = 1; n < 100000; n += 97)
+    {
+        const auto size = miopen::MemoryPool::GetSizeClass(n);
+        CHECK(size >= n);
+        CHECK(n <= 256 || (size - n) * 5 < size);
+    }
+}
+
+void check_reuse()
+{
+    heap h;
+    miopen::MemoryPool pool;
+    pool.SetAllocator(h.get());
+    pool.SetCapacity(miopen::MemoryPool::Unlimited);
+
+    auto a         = pool(1000);
+    void* a_buffer = a.get();
+    CHECK(pool.Reuse(1000) == nullptr);
+    a = nullptr;
+    CHECK(h.buffers.size() == 1);
+    CHECK(pool.GetStats().cached == 1024);
+
+    // Same size class.
+    auto b = pool(900);
+    CHECK(b.get() == a_buffer);
+    CHECK(h.allocations == 1);
+    auto c = pool(2000);
+    CHECK(h.allocations == 2);
+
+    auto stats = pool.GetStats();
+    CHECK(stats.in_use == 1024 + 2048);
+    CHECK(stats.cached == 0);
+    CHECK(stats.peak == 1024 + 2048);
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 2);
+
+    b = nullptr;
+    c = nullptr;
+    CHECK(h.buffers.size() == 2);
+    pool.Trim();
+    CHECK(h.buffers.empty());
+    CHECK(pool.GetStats().cached == 0);
+}
+
+void check_capacity()
+{
+    heap h;
+    miopen::MemoryPool pool;
+    pool.SetAllocator(h.get());
+    pool.SetCapacity(1024);
+
+    auto a = pool(1024);
+    auto b = pool(1024);
+    a      = nullptr;
+    b      = nullptr;
+    CHECK(h.buffers.size() == 1);
+    CHECK(pool.GetStats().cached == 1024);
+
+    // Without caching, buffers have their exact size and are freed at once.
+    pool.SetCapacity(0);
+    CHECK(h.buffers.empty());
+    auto c = pool(1000);
+    CHECK(pool.GetStats().in_use == 1000);
+    c = nullptr;
+    CHECK(h.buffers.empty());
+}
+
+void check_retry()
+{
+    heap h;
+    miopen::MemoryPool pool;
+    pool.SetAllocator(h.get());
+    pool.SetCapacity(miopen::MemoryPool::Unlimited);
+
+    pool(1024);
+    CHECK(h.buffers.size() == 1);
+    h.fail = true;
+    CHECK(throws([&] { pool(4096); }));
+    CHECK(h.buffers.empty());
+}
+
+void check_outlive()
+{
+    heap h;
+    heap other;
+    miopen::Allocator::ManageDataPtr a;
+    miopen::Allocator::ManageDataPtr b;
+    {
+        miopen::MemoryPool pool;
+        pool.SetAllocator(h.get());
+        pool.SetCapacity(miopen::MemoryPool::Unlimited);
+        a = pool(100);
+        pool(200);
+
+        // Buffers of the previous allocator are freed once released.
+        pool.SetAllocator(other.get());
+        CHECK(h.buffers.size() == 1);
+        b = pool(100);
+        CHECK(other.buffers.size() == 1);
+        a = nullptr;
+        CHECK(h.buffers.empty());
+        a = pool(100);
+        CHECK(other.buffers.size() == 2);
+    }
+    CHECK(other.buffers.size() == 2);
+    a = nullptr;
+    b = nullptr;
+    CHECK(other.buffers.empty());
+}
+
+int main()
+{
+    check_size_classes();
+    check_reuse();
+    check_capacity();
+    check_retry();
+    check_outlive();
+}
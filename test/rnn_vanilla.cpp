@@ -1285,25 +1285,36 @@ struct verify_forward_infer_rnn
         wlen[0] = weights.size();
         miopen::TensorDescriptor weightDesc(miopenFloat, wlen.data(), 1);
 
-        miopenRNNForwardInference(&handle,
-                                  rnnDesc,
-                                  seqLength,
-                                  inputDescs.data(),
-                                  input_dev.get(),
-                                  &hiddenDesc,
-                                  ((nohx) ? nullptr : handle.Write(initHidden).get()),
-                                  &hiddenDesc,
-                                  nullptr,
-                                  &weightDesc,
-                                  weights_dev.get(),
-                                  outputDescs.data(),
-                                  output_dev.get(),
-                                  &hiddenDesc,
-                                  ((nohy) ? nullptr : hy_dev.get()),
-                                  &hiddenDesc,
-                                  nullptr,
-                                  workSpace_dev.get(),
-                                  workSpaceSize);
+        const auto run = [&](Data_t out) {
+            miopenRNNForwardInference(&handle,
+                                      rnnDesc,
+                                      seqLength,
+                                      inputDescs.data(),
+                                      input_dev.get(),
+                                      &hiddenDesc,
+                                      ((nohx) ? nullptr : handle.Write(initHidden).get()),
+                                      &hiddenDesc,
+                                      nullptr,
+                                      &weightDesc,
+                                      weights_dev.get(),
+                                      outputDescs.data(),
+                                      out,
+                                      &hiddenDesc,
+                                      ((nohy) ? nullptr : hy_dev.get()),
+                                      &hiddenDesc,
+                                      nullptr,
+                                      workSpace_dev.get(),
+                                      workSpaceSize);
+        };
+
+        run(output_dev.get());
+
+        // The second call replays the kernels recorded by the first one. Its output goes to a new
+        // buffer, so anything the replay misses stays zero.
+        auto replay_output_dev = handle.Write(output);
+        run(replay_output_dev.get());
+        CHECK(handle.Read<T>(replay_output_dev, output.size()) ==
+              handle.Read<T>(output_dev, output.size()));
 
 #if(MIO_RNN_TEST_DEBUG == 2)
         auto outdata = handle.Read<T>(output_dev, output.size());
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/thread_pool.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "test.hpp"
+
+void check_results()
+{
+    miopen::ThreadPool pool(4);
+    std::vector<std::future<int>> results;
+    for(int i = 0; i < 100; ++i)
+        results.push_back(pool.Submit([i] { return i * i; }));
+    for(int i = 0; i < 100; ++i)
+        CHECK(results[i].get() == i * i);
+}
+
+void check_exception()
+{
+    miopen::ThreadPool pool(2);
+    auto result = pool.Submit([]() -> int { throw std::runtime_error("failed"); });
+    CHECK(throws([&] { result.get(); }));
+}
+
+void check_drain()
+{
+    std::atomic<int> done{0};
+    {
+        miopen::ThreadPool pool(3);
+        for(int i = 0; i < 50; ++i)
+            pool.Submit([&] { ++done; });
+    }
+    CHECK(done == 50);
+}
+
+int main()
+{
+    check_results();
+    check_exception();
+    check_drain();
+}
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/workspace_arena.hpp>
+#include "test.hpp"
+
+using miopen::WorkspaceStack;
+
+void check_stack()
+{
+    const std::size_t a = WorkspaceStack::Alignment;
+    WorkspaceStack stack;
+    CHECK(stack.Push(100) == WorkspaceStack::NoSpace);
+    CHECK(stack.GetRequired() == 100);
+    CHECK(stack.IsEmpty());
+
+    stack.SetCapacity(3 * a);
+    CHECK(stack.Push(100) == 0);
+    CHECK(stack.Push(a) == a);
+    CHECK(stack.Push(a + 1) == WorkspaceStack::NoSpace);
+    CHECK(stack.GetRequired() == 3 * a + 1);
+    CHECK(stack.Push(10) == 2 * a);
+
+    // Freed out of order, the space is reused once the workspaces above it are freed.
+    stack.Pop(a);
+    CHECK(stack.Push(10) == WorkspaceStack::NoSpace);
+    stack.Pop(2 * a);
+    CHECK(stack.Push(10) == a);
+    stack.Pop(a);
+    stack.Pop(0);
+    CHECK(stack.IsEmpty());
+    CHECK(stack.Push(3 * a) == 0);
+}
+
+int main() { check_stack(); }